@@ -0,0 +1,497 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file DevicePool.cpp
+ *
+ * @brief I/O device model implementation for the CS 446/646 operating
+ *        system simulator.
+ *
+ * @details Implements the device units, their real-time worker threads and
+ *          queues, the virtual-time busy model and the device statistics.
+ *
+ * @author Jia Li
+ *
+ * @version 1.01
+ *          Jia Li (16 October 2026)
+ *          Per-device-instance queues
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "DevicePool.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include <cctype>
+#include <cerrno>
+
+using namespace std;
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief deviceWorker function.
+ *
+ * @details body of each device unit's worker thread. Serves the unit's
+ *          queue in order, waits out each job on the simulation clock and
+ *          posts it to the completion queue.
+ *
+ * @param in: unitArg
+ *
+ * @note Jobs and the stop request each post the unit's semaphore, so
+ *       waking up to an empty queue means stop.
+ */
+static void *deviceWorker( void *unitArg )
+{
+   deviceUnit *unit = (deviceUnit *) unitArg;
+   devicePool *pool = unit->pool;
+   ioJob job;
+   long long wokeAt;
+   long long readyAt;
+   simTime previous = 0;
+
+   while( true )
+   {
+      sem_wait( &unit->jobsReady );
+
+      pthread_mutex_lock( &pool->poolLock );
+      if( unit->queue.empty( ) )
+      {
+         pthread_mutex_unlock( &pool->poolLock );
+         break;
+      }
+      job = unit->queue.front( );
+      pthread_mutex_unlock( &pool->poolLock );
+
+      wokeAt = readMonotonic( );
+      readyAt = ( job.readyAt > unit->lastFinished ) ? job.readyAt : unit->lastFinished;
+      job.dispatchDelay = wokeAt - readyAt;
+
+      job.intended = ( job.submitted > previous ) ? job.submitted : previous;
+      job.started = readClock( *pool->clock );
+      waitClock( *pool->clock, job.duration );
+      job.finished = readClock( *pool->clock );
+      previous = job.finished;
+
+      pthread_mutex_lock( &pool->poolLock );
+      unit->queue.pop_front( );
+      unit->jobCount++;
+      unit->busyTime = unit->busyTime + ( job.finished - job.started );
+      unit->queueWait = unit->queueWait + ( job.started - job.submitted );
+      job.postedAt = readMonotonic( );
+      unit->lastFinished = job.postedAt;
+      pool->completions.push_back( job );
+      pthread_cond_signal( &pool->completed );
+      pthread_mutex_unlock( &pool->poolLock );
+   }
+
+   return NULL;
+}
+
+/**
+ * @brief ioDevice function.
+ *
+ * @details true if a config device is an I/O device, which gets units in
+ *          the pool.
+ *
+ * @param in: fileData, device
+ *
+ * @note The processor and memory are not.
+ */
+bool ioDevice( configData &fileData, int device )
+{
+   const string &name = fileData.cycleData[device].componentName;
+
+   return !name.empty( ) && ( name.compare("Processor") != 0 ) && ( name.compare("Memory") != 0 );
+}
+
+/**
+ * @brief startDevicePool function.
+ *
+ * @details creates one unit per device instance named in the config and,
+ *          in real-time mode, starts each unit's worker thread.
+ *
+ * @param in: pool, clock, fileData
+ *
+ * @note Each I/O device gets as many units as its config quantity, one
+ *       if it has none. The processor and memory get none. Exits the simulator if a thread cannot be created.
+ */
+void startDevicePool( devicePool &pool, simClock &clock, configData &fileData )
+{
+   int device = 0;
+   int index = 0;
+   int count = 0;
+   int rc;
+   string name;
+   ostringstream unitName;
+   deviceUnit *unit;
+   pthread_condattr_t condAttr;
+
+   pool.clock = &clock;
+   pool.outstanding = 0;
+   pool.overheadCount = 0;
+   pool.totalOverhead = 0;
+   pool.maxOverhead = 0;
+   pthread_mutex_init( &pool.poolLock, NULL );
+   pthread_condattr_init( &condAttr );
+   pthread_condattr_setclock( &condAttr, CLOCK_MONOTONIC );
+   pthread_cond_init( &pool.completed, &condAttr );
+   pthread_condattr_destroy( &condAttr );
+
+   for( device = 0; device < (int) fileData.cycleData.size( ); device++ )
+   {
+      name = fileData.cycleData[device].componentName;
+      count = ioDevice( fileData, device ) ? fileData.cycleData[device].quantity : 0;
+
+      pool.firstUnit.push_back( pool.units.size( ) );
+      pool.unitCount.push_back( count );
+      pool.nextUnit.push_back( 0 );
+
+      for( index = 0; index < count; index++ )
+      {
+         unit = new deviceUnit;
+         unit->pool = &pool;
+         unit->device = device;
+         unit->number = index;
+         unit->lastFinished = 0;
+         unit->busyUntil = 0;
+         unit->jobCount = 0;
+         unit->busyTime = 0;
+         unit->queueWait = 0;
+
+         unitName.str( "" );
+         if( name.compare("Hard drive") == 0 )
+         {
+            unitName << "HDD " << index;
+         }
+         else if( name.compare("Printer") == 0 )
+         {
+            unitName << "PRNTR " << index;
+         }
+         else
+         {
+            unitName << (char) tolower( name[0] ) << name.substr( 1 );
+
+            if( count > 1 )
+            {
+               unitName << " " << index;
+            }
+         }
+         unit->name = unitName.str( );
+
+         pool.units.push_back( unit );
+
+         if( !clock.virtualTime )
+         {
+            sem_init( &unit->jobsReady, 0, 0 );
+            rc = pthread_create( &unit->worker, NULL, deviceWorker, (void*) unit );
+            if( rc )
+            {
+               cout << "Error: cannot create thread " << rc << endl;
+               exit(-1);
+            }
+         }
+      }
+   }
+}
+
+/**
+ * @brief pickDeviceUnit function.
+ *
+ * @details chooses the unit of a device that should serve the next job.
+ *
+ * @param in: pool, device
+ *
+ * @note Units are tried in round-robin order and the first idle one wins.
+ *       If every unit is busy the one that will free up first (virtual
+ *       time) or has the shortest queue (real time) is used. Returns -1 if
+ *       the device has no units.
+ */
+int pickDeviceUnit( devicePool &pool, int device )
+{
+   int index = 0;
+   int count = 0;
+   int candidate = 0;
+   int best = -1;
+   long long load = 0;
+   long long bestLoad = 0;
+   deviceUnit *unit;
+
+   if( ( device < 0 ) || ( device >= (int) pool.unitCount.size( ) ) || ( pool.unitCount[device] == 0 ) )
+   {
+      return -1;
+   }
+
+   count = pool.unitCount[device];
+
+   pthread_mutex_lock( &pool.poolLock );
+   for( index = 0; index < count; index++ )
+   {
+      candidate = pool.firstUnit[device] + ( pool.nextUnit[device] + index ) % count;
+      unit = pool.units[candidate];
+
+      if( pool.clock->virtualTime )
+      {
+         load = unit->busyUntil - readClock( *pool.clock );
+      }
+      else
+      {
+         load = unit->queue.size( );
+      }
+
+      if( load <= 0 )
+      {
+         best = candidate;
+         break;
+      }
+
+      if( ( best < 0 ) || ( load < bestLoad ) )
+      {
+         best = candidate;
+         bestLoad = load;
+      }
+   }
+   pthread_mutex_unlock( &pool.poolLock );
+
+   pool.nextUnit[device] = ( pool.units[best]->number + 1 ) % count;
+
+   return best;
+}
+
+/**
+ * @brief submitIO function.
+ *
+ * @details queues a job on its unit.
+ *
+ * @param in: pool, job
+ *
+ * @param out: job
+ *
+ * @note In virtual time the job's start and finish times are worked out
+ *       straight away from the time the unit becomes free, and the caller
+ *       schedules the completion. In real time the job is handed to the
+ *       unit's worker and comes back through waitCompletion.
+ */
+void submitIO( devicePool &pool, ioJob &job )
+{
+   deviceUnit *unit = pool.units[job.unit];
+
+   job.submitted = readClock( *pool.clock );
+
+   if( pool.clock->virtualTime )
+   {
+      job.started = ( unit->busyUntil > job.submitted ) ? unit->busyUntil : job.submitted;
+      job.finished = job.started + job.duration;
+      unit->busyUntil = job.finished;
+      unit->jobCount++;
+      unit->busyTime = unit->busyTime + job.duration;
+      unit->queueWait = unit->queueWait + ( job.started - job.submitted );
+      return;
+   }
+
+   job.readyAt = readMonotonic( );
+
+   pthread_mutex_lock( &pool.poolLock );
+   unit->queue.push_back( job );
+   pool.outstanding++;
+   pthread_mutex_unlock( &pool.poolLock );
+
+   sem_post( &unit->jobsReady );
+}
+
+/**
+ * @brief takeCompletion function.
+ *
+ * @details removes the oldest completed job and records its overhead.
+ *
+ * @param in: pool
+ *
+ * @param out: job
+ *
+ * @note poolLock must be held and the completion queue must not be empty.
+ */
+static void takeCompletion( devicePool &pool, ioJob &job )
+{
+   long long overhead;
+
+   job = pool.completions.front( );
+   pool.completions.pop_front( );
+   pool.outstanding--;
+
+   overhead = job.dispatchDelay + ( readMonotonic( ) - job.postedAt );
+   pool.overheadCount++;
+   pool.totalOverhead = pool.totalOverhead + overhead;
+   if( overhead > pool.maxOverhead )
+   {
+      pool.maxOverhead = overhead;
+   }
+}
+
+/**
+ * @brief waitCompletion function.
+ *
+ * @details real-time only. Blocks until either a device job completes or
+ *          the deadline passes.
+ *
+ * @param in: pool, hasDeadline, deadline
+ *
+ * @param out: job
+ *
+ * @note Returns true with the completed job, or false once the deadline
+ *       is reached. The wait sleeps on a CLOCK_MONOTONIC condition
+ *       variable and spins for the clock's spin time at the end, like
+ *       waitClock, and the deadline overshoot goes into the timer
+ *       statistics.
+ */
+bool waitCompletion( devicePool &pool, bool hasDeadline, simTime deadline, ioJob &job )
+{
+   simClock &clock = *pool.clock;
+   struct timespec wakeTime;
+   struct timespec target;
+   long long targetTime = 0;
+   bool found = false;
+
+   if( hasDeadline )
+   {
+      wakeTime = clockDeadline( clock, deadline - clock.spinTime );
+      target = clockDeadline( clock, deadline );
+      targetTime = target.tv_sec * NSEC_PER_SEC + target.tv_nsec;
+   }
+
+   pthread_mutex_lock( &pool.poolLock );
+   while( pool.completions.empty( ) )
+   {
+      if( !hasDeadline )
+      {
+         pthread_cond_wait( &pool.completed, &pool.poolLock );
+      }
+      else if( pthread_cond_timedwait( &pool.completed, &pool.poolLock, &wakeTime ) == ETIMEDOUT )
+      {
+         break;
+      }
+   }
+
+   if( !pool.completions.empty( ) )
+   {
+      takeCompletion( pool, job );
+      found = true;
+   }
+   pthread_mutex_unlock( &pool.poolLock );
+
+   while( !found && ( readMonotonic( ) < targetTime ) )
+   {
+      // final spin for accuracy, still watching for completions
+      pthread_mutex_lock( &pool.poolLock );
+      if( !pool.completions.empty( ) )
+      {
+         takeCompletion( pool, job );
+         found = true;
+      }
+      pthread_mutex_unlock( &pool.poolLock );
+   }
+
+   if( !found )
+   {
+      recordOvershoot( clock, readMonotonic( ) - targetTime );
+   }
+
+   return found;
+}
+
+/**
+ * @brief stopDevicePool function.
+ *
+ * @details stops and joins the worker threads and frees the units.
+ *
+ * @param in: pool
+ *
+ * @note Workers finish any jobs still in their queues first.
+ */
+void stopDevicePool( devicePool &pool )
+{
+   int index = 0;
+   void *status;
+   deviceUnit *unit;
+
+   for( index = 0; index < (int) pool.units.size( ); index++ )
+   {
+      unit = pool.units[index];
+
+      if( !pool.clock->virtualTime )
+      {
+         sem_post( &unit->jobsReady );
+         pthread_join( unit->worker, &status );
+         sem_destroy( &unit->jobsReady );
+      }
+
+      delete unit;
+   }
+
+   pool.units.clear( );
+
+   pthread_cond_destroy( &pool.completed );
+   pthread_mutex_destroy( &pool.poolLock );
+}
+
+/**
+ * @brief printDevicePoolSummary function.
+ *
+ * @details prints the per-unit device statistics to the monitor, and the
+ *          worker thread overhead in real-time mode.
+ *
+ * @param in: pool, makespan
+ *
+ * @note Utilization is a unit's busy time divided by the makespan, so
+ *       units that worked in parallel can each be close to 1.
+ */
+void printDevicePoolSummary( devicePool &pool, simTime makespan )
+{
+   int index = 0;
+   double utilization = 0.0;
+   double meanWait = 0.0;
+   double meanOverhead = 0.0;
+   streamsize oldPrecision = cout.precision( );
+   deviceUnit *unit;
+
+   cout << fixed << setprecision(3);
+
+   for( index = 0; index < (int) pool.units.size( ); index++ )
+   {
+      unit = pool.units[index];
+      utilization = 0.0;
+      meanWait = 0.0;
+
+      if( makespan > 0 )
+      {
+         utilization = (double) unit->busyTime / makespan;
+      }
+
+      if( unit->jobCount > 0 )
+      {
+         meanWait = toSeconds( unit->queueWait ) / unit->jobCount;
+      }
+
+      cout << "Device " << unit->name << ": " << unit->jobCount << " jobs, busy ";
+      cout << toSeconds( unit->busyTime ) << " sec, utilization " << utilization;
+      cout << ", mean queue wait " << meanWait << " sec" << endl;
+   }
+
+   if( !pool.clock->virtualTime )
+   {
+      if( pool.overheadCount > 0 )
+      {
+         meanOverhead = (double) pool.totalOverhead / pool.overheadCount / NSEC_PER_USEC;
+      }
+
+      cout << "I/O worker threads: " << pool.units.size( ) << endl;
+      cout << "I/O handoff overhead mean (usec): " << meanOverhead << endl;
+      cout << "I/O handoff overhead max (usec): " << (double) pool.maxOverhead / NSEC_PER_USEC << endl;
+   }
+
+   cout.unsetf( ios::floatfield );
+   cout.precision( oldPrecision );
+}
@@ -0,0 +1,125 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file DevicePool.h
+ *
+ * @brief I/O device model for the CS 446/646 operating system simulator.
+ *
+ * @details Every device instance (HDD 0, HDD 1, PRNTR 0, the keyboard and
+ *          so on) is a unit with its own FIFO job queue, so I/O on
+ *          different units overlaps. In real-time mode each unit has a
+ *          persistent worker thread, created at startup, that waits out its
+ *          jobs on the simulation clock and posts them to a shared
+ *          completion queue for the engine. In virtual-time mode a unit is
+ *          just the time at which it becomes free, and the engine schedules
+ *          the completion itself.
+ *
+ * @author Jia Li
+ *
+ * @version 1.01
+ *          Jia Li (16 October 2026)
+ *          Per-device-instance queues
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef DEVICE_POOL_H
+#define DEVICE_POOL_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <pthread.h>
+#include <semaphore.h>
+#include "data.h"
+#include "SimClock.h"
+
+using namespace std;
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct ioJob
+{
+   int unit;
+   int process;
+   simTime duration;
+
+   // simulation times of the job, filled in by the device model
+   simTime submitted;
+   simTime started;
+   simTime finished;
+
+   // real time: when the job could have started, its submission or the
+   // unit's previous completion if that was later
+   simTime intended;
+
+   // monotonic nanoseconds, used for the thread overhead statistics
+   long long readyAt;
+   long long dispatchDelay;
+   long long postedAt;
+};
+
+struct deviceUnit
+{
+   struct devicePool *pool;
+   int device;
+   int number;
+   string name;
+
+   // real-time worker and its queue; the job in service stays at the front
+   pthread_t worker;
+   deque<ioJob> queue;
+   sem_t jobsReady;
+   long long lastFinished;
+
+   // virtual-time state
+   simTime busyUntil;
+
+   // statistics
+   long long jobCount;
+   simTime busyTime;
+   simTime queueWait;
+};
+
+struct devicePool
+{
+   simClock *clock;
+   vector<deviceUnit*> units;
+   vector<int> firstUnit;
+   vector<int> unitCount;
+   vector<int> nextUnit;
+
+   // completions waiting for the engine, guarded by poolLock
+   pthread_mutex_t poolLock;
+   pthread_cond_t completed;
+   deque<ioJob> completions;
+   int outstanding;
+
+   // thread overhead statistics
+   long long overheadCount;
+   long long totalOverhead;
+   long long maxOverhead;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+bool ioDevice( configData &fileData, int device );
+
+void startDevicePool( devicePool &pool, simClock &clock, configData &fileData );
+
+int pickDeviceUnit( devicePool &pool, int device );
+
+void submitIO( devicePool &pool, ioJob &job );
+
+bool waitCompletion( devicePool &pool, bool hasDeadline, simTime deadline, ioJob &job );
+
+void stopDevicePool( devicePool &pool );
+
+void printDevicePoolSummary( devicePool &pool, simTime makespan );
+
+#endif // DEVICE_POOL_H
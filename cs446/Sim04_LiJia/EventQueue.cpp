@@ -0,0 +1,382 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file EventQueue.cpp
+ *
+ * @brief Pending-event set implementation for the CS 446/646 operating
+ *        system simulator.
+ *
+ * @details A binary min-heap keyed on event time and insertion order, which
+ *          becomes a calendar queue (R. Brown, CACM 1988) when it grows
+ *          large. As in a ladder queue, the calendar's buckets are not kept
+ *          sorted; a day's events are sorted, by the heap, only when the
+ *          day comes.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "EventQueue.h"
+#include <algorithm>
+
+using namespace std;
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief laterEvent function.
+ *
+ * @details heap ordering; true if one comes out after two.
+ *
+ * @param in: one, two
+ *
+ * @note N/A.
+ */
+static bool laterEvent( const simEvent &one, const simEvent &two )
+{
+   if( one.time != two.time )
+   {
+      return one.time > two.time;
+   }
+
+   return one.sequence > two.sequence;
+}
+
+/**
+ * @brief calendarInsert function.
+ *
+ * @details adds an event to the calendar.
+ *
+ * @param in: events, event
+ *
+ * @note An event before the end of the current day goes in the heap, any
+ *       other at the front of its bucket.
+ */
+static void calendarInsert( eventQueue &events, const simEvent &event )
+{
+   int &bucket = events.buckets[( event.time / events.width ) & ( events.buckets.size( ) - 1 )];
+   int node = events.freeNode;
+
+   events.count++;
+
+   if( event.time < events.dayEnd )
+   {
+      events.heap.push_back( event );
+      push_heap( events.heap.begin( ), events.heap.end( ), laterEvent );
+      return;
+   }
+
+   if( node < 0 )
+   {
+      node = events.nodes.size( );
+      events.nodes.push_back( eventNode( ) );
+   }
+   else
+   {
+      events.freeNode = events.nodes[node].next;
+   }
+
+   events.nodes[node].event = event;
+   events.nodes[node].next = bucket;
+   bucket = node;
+}
+
+/**
+ * @brief rebuildQueue function.
+ *
+ * @details moves every pending event into a heap or into a calendar sized
+ *          for them.
+ *
+ * @param in: events, calendar
+ *
+ * @note The calendar gets a bucket per event, rounded up to a power of
+ *       two, and days as long as the earliest nine tenths of the events
+ *       span divided by their number. A year then covers them, and each
+ *       day holds about one, wherever the events lie in time; the few far
+ *       off come round in later years. Sizing from the whole queue, not a
+ *       sample of its front as Brown does, keeps a burst of events at the
+ *       same time from making the days too short. The current day is the
+ *       earliest event's.
+ */
+static void rebuildQueue( eventQueue &events, bool calendar )
+{
+   vector<simEvent> pending;
+   vector<simTime> times;
+   size_t bucketCount = 2;
+   size_t spanned = 0;
+   size_t index = 0;
+   simTime first = 0;
+   int node = 0;
+
+   pending.swap( events.heap );
+
+   if( events.calendar )
+   {
+      for( index = 0; index < events.buckets.size( ); index++ )
+      {
+         for( node = events.buckets[index]; node >= 0; node = events.nodes[node].next )
+         {
+            pending.push_back( events.nodes[node].event );
+         }
+      }
+   }
+
+   events.calendar = calendar;
+   events.buckets.clear( );
+   events.nodes.clear( );
+   events.freeNode = -1;
+   events.count = 0;
+
+   if( !calendar )
+   {
+      events.heap.swap( pending );
+      make_heap( events.heap.begin( ), events.heap.end( ), laterEvent );
+      return;
+   }
+
+   while( bucketCount < pending.size( ) )
+   {
+      bucketCount = bucketCount * 2;
+   }
+
+   times.resize( pending.size( ) );
+   for( index = 0; index < pending.size( ); index++ )
+   {
+      times[index] = pending[index].time;
+   }
+
+   spanned = max( times.size( ) * 9 / 10, (size_t) 1 );
+   nth_element( times.begin( ), times.begin( ) + spanned - 1, times.end( ) );
+   first = *min_element( times.begin( ), times.begin( ) + spanned );
+
+   events.width = max( ( times[spanned - 1] - first ) / (simTime) spanned, (simTime) 1 );
+   events.buckets.assign( bucketCount, -1 );
+   events.nodes.reserve( bucketCount * 2 );
+   events.current = ( first / events.width ) & ( bucketCount - 1 );
+   events.dayEnd = ( first / events.width + 1 ) * events.width;
+
+   for( index = 0; index < pending.size( ); index++ )
+   {
+      calendarInsert( events, pending[index] );
+   }
+}
+
+/**
+ * @brief calendarFind function.
+ *
+ * @details moves the calendar on to the first day with an event.
+ *
+ * @param in: events
+ *
+ * @note The calendar must not be empty. The earliest event is then at the
+ *       top of the heap. Each new day takes its events out of its bucket,
+ *       leaving those of later years. A whole year of empty days means the
+ *       days have become too short for the events pending, so the calendar
+ *       is rebuilt for them instead.
+ */
+static void calendarFind( eventQueue &events )
+{
+   size_t mask = events.buckets.size( ) - 1;
+   size_t step = 0;
+   int *link = NULL;
+   int node = -1;
+
+   for( step = 0; events.heap.empty( ); step++ )
+   {
+      if( step > mask )
+      {
+         rebuildQueue( events, true );
+         return;
+      }
+
+      events.current = ( events.current + 1 ) & mask;
+      events.dayEnd = events.dayEnd + events.width;
+      link = &events.buckets[events.current];
+
+      while( *link >= 0 )
+      {
+         node = *link;
+
+         if( events.nodes[node].event.time < events.dayEnd )
+         {
+            events.heap.push_back( events.nodes[node].event );
+            *link = events.nodes[node].next;
+            events.nodes[node].next = events.freeNode;
+            events.freeNode = node;
+         }
+         else
+         {
+            link = &events.nodes[node].next;
+         }
+      }
+
+      make_heap( events.heap.begin( ), events.heap.end( ), laterEvent );
+   }
+}
+
+/**
+ * @brief initEventQueue function.
+ *
+ * @details empties the queue.
+ *
+ * @param in: events
+ *
+ * @note N/A.
+ */
+void initEventQueue( eventQueue &events )
+{
+   events.heap.clear( );
+   events.calendar = false;
+   events.buckets.clear( );
+   events.nodes.clear( );
+   events.freeNode = -1;
+   events.count = 0;
+   events.width = 1;
+   events.current = 0;
+   events.dayEnd = 0;
+   events.nextSequence = 0;
+}
+
+/**
+ * @brief pushEvent function.
+ *
+ * @details adds an event.
+ *
+ * @param in: events, event
+ *
+ * @note Stamps the event with its insertion order. A calendar holding
+ *       twice as many events as it has buckets is rebuilt bigger.
+ */
+void pushEvent( eventQueue &events, simEvent &event )
+{
+   event.sequence = events.nextSequence;
+   events.nextSequence++;
+
+   if( events.calendar )
+   {
+      calendarInsert( events, event );
+
+      if( events.count > 2 * events.buckets.size( ) )
+      {
+         rebuildQueue( events, true );
+      }
+      return;
+   }
+
+   events.heap.push_back( event );
+   push_heap( events.heap.begin( ), events.heap.end( ), laterEvent );
+
+   if( events.heap.size( ) >= CALENDAR_EVENTS )
+   {
+      rebuildQueue( events, true );
+   }
+}
+
+/**
+ * @brief popEvent function.
+ *
+ * @details removes the earliest event.
+ *
+ * @param in: events
+ *
+ * @param out: event
+ *
+ * @note Returns false if the queue is empty. A calendar down to half as
+ *       many events as it has buckets is rebuilt smaller, or as a heap.
+ */
+bool popEvent( eventQueue &events, simEvent &event )
+{
+   if( emptyEventQueue( events ) )
+   {
+      return false;
+   }
+
+   if( events.calendar )
+   {
+      calendarFind( events );
+   }
+
+   pop_heap( events.heap.begin( ), events.heap.end( ), laterEvent );
+   event = events.heap.back( );
+   events.heap.pop_back( );
+
+   if( events.calendar )
+   {
+      events.count--;
+
+      if( events.count < HEAP_EVENTS )
+      {
+         rebuildQueue( events, false );
+      }
+      else if( events.count < events.buckets.size( ) / 2 )
+      {
+         rebuildQueue( events, true );
+      }
+   }
+
+   return true;
+}
+
+/**
+ * @brief peekEvent function.
+ *
+ * @details copies the earliest event without removing it.
+ *
+ * @param in: events
+ *
+ * @param out: event
+ *
+ * @note Returns false if the queue is empty.
+ */
+bool peekEvent( eventQueue &events, simEvent &event )
+{
+   if( emptyEventQueue( events ) )
+   {
+      return false;
+   }
+
+   if( events.calendar )
+   {
+      calendarFind( events );
+   }
+
+   event = events.heap.front( );
+
+   return true;
+}
+
+/**
+ * @brief emptyEventQueue function.
+ *
+ * @details true if no events are pending.
+ *
+ * @param in: events
+ *
+ * @note N/A.
+ */
+bool emptyEventQueue( eventQueue &events )
+{
+   return events.calendar ? ( events.count == 0 ) : events.heap.empty( );
+}
+
+/**
+ * @brief nextEventTime function.
+ *
+ * @details time of the earliest pending event.
+ *
+ * @param in: events
+ *
+ * @note 0 if the queue is empty.
+ */
+simTime nextEventTime( eventQueue &events )
+{
+   simEvent event = simEvent( );
+
+   peekEvent( events, event );
+
+   return event.time;
+}
@@ -0,0 +1,99 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file EventQueue.h
+ *
+ * @brief Pending-event set for the CS 446/646 operating system simulator.
+ *
+ * @details Holds the future events of the simulation engine, ordered by
+ *          time. Events at the same time come out in the order they were
+ *          added, which keeps virtual-time runs deterministic.
+ *
+ *          A few events are kept in a binary heap. Past CALENDAR_EVENTS,
+ *          as when many processes wait on devices, they move to a
+ *          calendar queue, whose insert and removal take constant time
+ *          on average however many events are pending, and back to the
+ *          heap once fewer than HEAP_EVENTS are left. Only the events of
+ *          the calendar's current day are kept in order, in the heap, so a
+ *          day crowded with events costs no more than the heap would.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "SimClock.h"
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+// pending events at which the heap turns into a calendar
+const size_t CALENDAR_EVENTS = 1024;
+
+// pending events below which the calendar turns back into a heap
+const size_t HEAP_EVENTS = 256;
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct simEvent
+{
+   simTime time;
+   long long sequence;
+   int type;
+   int process;
+   int unit;
+};
+
+// calendar entry; next is the index of the next node of its bucket, or -1
+struct eventNode
+{
+   simEvent event;
+   int next;
+};
+
+struct eventQueue
+{
+   // every event while the queue is small; the events of the current day
+   // and any earlier once it is a calendar
+   vector<simEvent> heap;
+
+   // calendar: bucket i lists, in no order, the later events of every day
+   // that is i modulo the bucket count, a day being width microseconds;
+   // the current day is in bucket current and ends at dayEnd
+   bool calendar;
+   vector<int> buckets;
+   vector<eventNode> nodes;
+   int freeNode;
+   size_t count;
+   simTime width;
+   size_t current;
+   simTime dayEnd;
+
+   long long nextSequence;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+void initEventQueue( eventQueue &events );
+
+void pushEvent( eventQueue &events, simEvent &event );
+
+bool popEvent( eventQueue &events, simEvent &event );
+
+bool peekEvent( eventQueue &events, simEvent &event );
+
+bool emptyEventQueue( eventQueue &events );
+
+simTime nextEventTime( eventQueue &events );
+
+#endif // EVENT_QUEUE_H
@@ -0,0 +1,649 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file LogSink.cpp
+ *
+ * @brief Simulator log sink implementation for the CS 446/646 operating
+ *        system simulator.
+ *
+ * @details Formats simulator events into log lines and writes each line to
+ *          every destination selected by the configuration.
+ *
+ *          The ring is a bounded multi-producer queue: each slot carries a
+ *          sequence number, a producer claims a position with one
+ *          compare-and-swap and publishes the slot by advancing its
+ *          sequence, and the single writer frees it the same way.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "LogSink.h"
+#include <iostream>
+#include <cstdio>
+#include <cctype>
+#include <cstring>
+#include <sched.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief drainLog function.
+ *
+ * @details formats up to LOG_BATCH waiting events and writes them out, or
+ *          stores them as trace records in trace mode.
+ *
+ * @param in: sink, block
+ *
+ * @note Only the writer thread calls this. Returns the number of events
+ *       written, 0 if the ring was empty.
+ */
+static int drainLog( logSink &sink, vector<char> &block )
+{
+   logRing &ring = *sink.ring;
+   logSlot *slot = NULL;
+   traceRecord record = traceRecord( );
+   size_t length = 0;
+   int count = 0;
+
+   while( count < LOG_BATCH )
+   {
+      slot = &ring.slots[ring.dequeuePos & ( LOG_RING_SIZE - 1 )];
+
+      if( slot->sequence.load( memory_order_acquire ) != ring.dequeuePos + 1 )
+      {
+         break;
+      }
+
+      if( sink.toTrace )
+      {
+         record.time = slot->event.time;
+         record.processID = slot->event.processID;
+         record.instance = slot->event.instance;
+         record.address = slot->event.address;
+         record.device = slot->event.device;
+         record.type = slot->event.type;
+         memcpy( &block[length], &record, sizeof( record ) );
+         length += sizeof( record );
+      }
+      else
+      {
+         length += formatLogEvent( sink, slot->event, &block[length] );
+      }
+
+      slot->sequence.store( ring.dequeuePos + LOG_RING_SIZE, memory_order_release );
+      ring.dequeuePos++;
+      count++;
+   }
+
+   if( length > 0 )
+   {
+      if( sink.toMonitor )
+      {
+         cout.write( &block[0], length );
+         cout.flush( );
+      }
+
+      if( sink.toFile )
+      {
+         sink.fout.write( &block[0], length );
+         sink.fout.flush( );
+      }
+
+      if( sink.toTrace )
+      {
+         sink.trace.write( &block[0], length );
+      }
+   }
+
+   return count;
+}
+
+/**
+ * @brief logWriter function.
+ *
+ * @details writer thread of the log sink.
+ *
+ * @param in: arg, the sink
+ *
+ * @note Sleeps LOG_IDLE_USEC whenever the ring is empty. The stop flag is
+ *       read before the ring is found empty, so every event pushed before
+ *       closeLogSink is written.
+ */
+static void *logWriter( void *arg )
+{
+   logSink &sink = *(logSink *) arg;
+   vector<char> block( LOG_BATCH * ( LOG_LINE_SIZE + 1 ) );
+   bool stopping = false;
+
+   while( true )
+   {
+      stopping = sink.ring->stopping.load( memory_order_acquire );
+
+      if( drainLog( sink, block ) == 0 )
+      {
+         if( stopping )
+         {
+            break;
+         }
+
+         usleep( LOG_IDLE_USEC );
+      }
+   }
+
+   return NULL;
+}
+
+/**
+ * @brief writeTraceHeader function.
+ *
+ * @details opens the trace file and writes its header and name tables.
+ *
+ * @param in: sink, tracePath
+ *
+ * @note Names longer than TRACE_NAME_SIZE - 1 are cut short. Returns false
+ *       if the file cannot be opened.
+ */
+static bool writeTraceHeader( logSink &sink, const char tracePath[] )
+{
+   traceHeader header = traceHeader( );
+   traceName entry;
+   size_t index = 0;
+
+   sink.trace.open( tracePath, ios::binary );
+
+   if( !sink.trace.is_open( ) )
+   {
+      return false;
+   }
+
+   memcpy( header.magic, TRACE_MAGIC, sizeof( TRACE_MAGIC ) );
+   header.version = TRACE_VERSION;
+   header.recordSize = sizeof( traceRecord );
+   header.nameCount = sink.deviceNames.size( );
+   sink.trace.write( (const char *) &header, sizeof( header ) );
+
+   for( index = 0; index < sink.deviceNames.size( ); index++ )
+   {
+      entry = traceName( );
+      strncpy( entry.device, sink.deviceNames[index].c_str( ), TRACE_NAME_SIZE - 1 );
+      strncpy( entry.unit, sink.unitNames[index].c_str( ), TRACE_NAME_SIZE - 1 );
+      sink.trace.write( (const char *) &entry, sizeof( entry ) );
+   }
+
+   return true;
+}
+
+/**
+ * @brief openLogSink function.
+ *
+ * @details selects the destinations from the log criteria, opens the log
+ *          file if needed and builds the device name tables.
+ *
+ * @param in: sink, fileData, tracePath
+ *
+ * @note A tracePath other than NULL replaces the log criteria: every event
+ *       goes to that binary trace file and nothing is formatted. Returns
+ *       false if the log or trace file cannot be opened; otherwise the
+ *       writer thread is running when it returns. The meta-data
+ *       descriptions are the lower case component names. Hard drives and
+ *       printers are always numbered in the log, other devices only when
+ *       the config gives them more than one unit.
+ */
+bool openLogSink( logSink &sink, configData &fileData, const char tracePath[] )
+{
+   int index = 0;
+   string name;
+
+   sink.toTrace = ( tracePath != NULL );
+   sink.toMonitor = !sink.toTrace &&
+                    ( ( fileData.logData.logCriteria.compare("Both") == 0 ) ||
+                      ( fileData.logData.logCriteria.compare("Monitor") == 0 ) );
+   sink.toFile = !sink.toTrace &&
+                 ( ( fileData.logData.logCriteria.compare("Both") == 0 ) ||
+                   ( fileData.logData.logCriteria.compare("File") == 0 ) );
+
+   sink.deviceNames.clear( );
+   sink.unitNames.clear( );
+
+   for( index = 0; index < (int) fileData.cycleData.size( ); index++ )
+   {
+      name = fileData.cycleData[index].componentName;
+
+      if( !name.empty( ) )
+      {
+         name[0] = tolower( name[0] );
+      }
+
+      sink.deviceNames.push_back( name );
+
+      if( name.compare("hard drive") == 0 )
+      {
+         sink.unitNames.push_back( "HDD" );
+      }
+      else if( name.compare("printer") == 0 )
+      {
+         sink.unitNames.push_back( "PRNTR" );
+      }
+      else if( fileData.cycleData[index].quantity > 1 )
+      {
+         sink.unitNames.push_back( name );
+      }
+      else
+      {
+         sink.unitNames.push_back( "" );
+      }
+   }
+
+   if( sink.toFile )
+   {
+      sink.fout.open( fileData.logData.logFilePath );
+
+      if( !sink.fout.is_open( ) )
+      {
+         cout << "Cannot open log file " << fileData.logData.logFilePath << endl;
+         return false;
+      }
+   }
+
+   if( sink.toTrace && ( writeTraceHeader( sink, tracePath ) == false ) )
+   {
+      cout << "Cannot open trace file " << tracePath << endl;
+      return false;
+   }
+
+   sink.ring = new logRing;
+
+   for( index = 0; index < LOG_RING_SIZE; index++ )
+   {
+      sink.ring->slots[index].sequence.store( index, memory_order_relaxed );
+   }
+
+   sink.ring->enqueuePos.store( 0, memory_order_relaxed );
+   sink.ring->dequeuePos = 0;
+   sink.ring->stopping.store( false, memory_order_relaxed );
+
+   pthread_create( &sink.writer, NULL, logWriter, &sink );
+
+   return true;
+}
+
+/**
+ * @brief appendText function.
+ *
+ * @details appends text to a log line.
+ *
+ * @param in: line, length, text
+ *
+ * @param out: line, length
+ *
+ * @note Stops at the end of the line buffer, leaving room for the newline.
+ */
+static void appendText( char line[], int &length, const char text[] )
+{
+   while( ( *text != '\0' ) && ( length < LOG_LINE_SIZE - 1 ) )
+   {
+      line[length++] = *text++;
+   }
+}
+
+/**
+ * @brief appendNumber function.
+ *
+ * @details appends a decimal number to a log line.
+ *
+ * @param in: line, length, number
+ *
+ * @param out: line, length
+ *
+ * @note N/A.
+ */
+static void appendNumber( char line[], int &length, long long number )
+{
+   char digits[24];
+   int count = sizeof( digits ) - 1;
+   unsigned long long value = ( number < 0 ) ? 0ULL - number : number;
+
+   digits[count] = '\0';
+
+   do
+   {
+      digits[--count] = '0' + value % 10;
+      value = value / 10;
+   } while( value > 0 );
+
+   if( number < 0 )
+   {
+      digits[--count] = '-';
+   }
+
+   appendText( line, length, digits + count );
+}
+
+/**
+ * @brief formatLogTime function.
+ *
+ * @details writes a time in seconds as printf's %.6g would.
+ *
+ * @param in: time
+ *
+ * @param out: text
+ *
+ * @note The microseconds are rounded to six significant digits in integer
+ *       arithmetic, which lands where printf does on the double except at
+ *       an exact half. Halves, times under 100 usec and times that need an
+ *       exponent (a million seconds on) are left to snprintf. Returns the
+ *       length.
+ */
+static int formatLogTime( simTime time, char text[] )
+{
+   long long scale = 1;
+   long long mantissa = time;
+   long long rest = 0;
+   long long unit = 1000000;
+   int places = 6;
+   int digits = 0;
+   int length = 0;
+
+   for( rest = time; rest > 0; rest = rest / 10 )
+   {
+      digits++;
+   }
+
+   if( ( time < 100 ) || ( digits > 12 ) )
+   {
+      return snprintf( text, LOG_LINE_SIZE, "%.6g", toSeconds( time ) );
+   }
+
+   if( digits > 6 )
+   {
+      for( places = digits; places > 6; places-- )
+      {
+         scale = scale * 10;
+      }
+
+      mantissa = time / scale;
+      rest = time % scale;
+
+      if( rest * 2 == scale )
+      {
+         return snprintf( text, LOG_LINE_SIZE, "%.6g", toSeconds( time ) );
+      }
+
+      mantissa = mantissa + ( ( rest * 2 > scale ) ? 1 : 0 );
+      places = 12 - digits;
+      unit = unit / scale;
+
+      if( mantissa == 1000000 )
+      {
+         if( places == 0 )
+         {
+            return snprintf( text, LOG_LINE_SIZE, "%.6g", toSeconds( time ) );
+         }
+
+         mantissa = 100000;
+         places--;
+         unit = unit / 10;
+      }
+   }
+
+   appendNumber( text, length, mantissa / unit );
+   rest = mantissa % unit;
+
+   while( ( places > 0 ) && ( rest % 10 == 0 ) )
+   {
+      rest = rest / 10;
+      unit = unit / 10;
+      places--;
+   }
+
+   if( places > 0 )
+   {
+      text[length++] = '.';
+
+      for( unit = unit / 10; unit > 0; unit = unit / 10 )
+      {
+         text[length++] = '0' + ( rest / unit ) % 10;
+      }
+   }
+
+   return length;
+}
+
+/**
+ * @brief formatLogEvent function.
+ *
+ * @details renders one event as a newline terminated log line.
+ *
+ * @param in: sink, event
+ *
+ * @param out: line
+ *
+ * @note Returns the length of the line. Times use six significant digits,
+ *       the same as the original setprecision(6) output. The lines are
+ *       put together by hand rather than with snprintf, which the writer
+ *       would otherwise spend most of its time in.
+ */
+int formatLogEvent( logSink &sink, const logEvent &event, char line[] )
+{
+   int length = 0;
+   const char *name = "";
+   const char *direction = " input";
+   const char *unitName = "";
+   char address[16];
+
+   length = formatLogTime( event.time, line );
+   appendText( line, length, " - " );
+
+   if( ( event.device >= 0 ) && ( event.device < (int) sink.deviceNames.size( ) ) )
+   {
+      name = sink.deviceNames[event.device].c_str( );
+      unitName = sink.unitNames[event.device].c_str( );
+   }
+
+   if( ( event.type == OUTPUT_START ) || ( event.type == OUTPUT_END ) )
+   {
+      direction = " output";
+   }
+
+   if( ( event.type == MEMORY_ALLOCATED ) || ( event.type == PAGE_FAULT ) || ( event.type == PAGE_LOADED ) )
+   {
+      snprintf( address, sizeof( address ), "0x%08x", event.address );
+   }
+
+   if( ( event.type >= CPU_START ) && ( event.type <= PAGE_LOADED ) )
+   {
+      appendText( line, length, "Process" );
+      appendNumber( line, length, event.processID );
+      appendText( line, length, ": " );
+   }
+
+   switch( event.type )
+   {
+      case SIM_START:
+         appendText( line, length, "Simulator program starting" );
+         break;
+
+      case PROCESS_PREPARE:
+         appendText( line, length, "OS: preparing process " );
+         appendNumber( line, length, event.processID );
+         break;
+
+      case PROCESS_START:
+         appendText( line, length, "OS: starting process " );
+         appendNumber( line, length, event.processID );
+         break;
+
+      case PROCESS_REMOVE:
+         appendText( line, length, "OS: removing process " );
+         appendNumber( line, length, event.processID );
+         break;
+
+      case CPU_START:
+         appendText( line, length, "start processing action" );
+         if( event.instance >= 0 )
+         {
+            appendText( line, length, " on core " );
+            appendNumber( line, length, event.instance );
+         }
+         break;
+
+      case CPU_END:
+         appendText( line, length, "end processing action" );
+         break;
+
+      case CPU_PREEMPT:
+         appendText( line, length, "processing action preempted" );
+         break;
+
+      case MEMORY_ALLOCATE:
+         appendText( line, length, "allocating memory" );
+         break;
+
+      case MEMORY_ALLOCATED:
+         appendText( line, length, "memory allocated at " );
+         appendText( line, length, address );
+         break;
+
+      case MEMORY_FAILED:
+         appendText( line, length, "memory allocation failed" );
+         break;
+
+      case BLOCK_START:
+         appendText( line, length, "start memory blocking" );
+         break;
+
+      case BLOCK_END:
+         appendText( line, length, "end memory blocking" );
+         break;
+
+      case INPUT_START:
+      case OUTPUT_START:
+         appendText( line, length, "start " );
+         appendText( line, length, name );
+         appendText( line, length, direction );
+         break;
+
+      case INPUT_END:
+      case OUTPUT_END:
+         appendText( line, length, "end " );
+         appendText( line, length, name );
+         appendText( line, length, direction );
+
+         if( ( event.instance >= 0 ) && ( unitName[0] != '\0' ) )
+         {
+            appendText( line, length, " on " );
+            appendText( line, length, unitName );
+            appendText( line, length, " " );
+            appendNumber( line, length, event.instance );
+         }
+         break;
+
+      case PAGE_FAULT:
+         appendText( line, length, "page fault at " );
+         appendText( line, length, address );
+         break;
+
+      case PAGE_LOADED:
+         appendText( line, length, "page loaded at " );
+         appendText( line, length, address );
+
+         if( ( event.instance >= 0 ) && ( unitName[0] != '\0' ) )
+         {
+            appendText( line, length, " from " );
+            appendText( line, length, unitName );
+            appendText( line, length, " " );
+            appendNumber( line, length, event.instance );
+         }
+         break;
+   }
+
+   line[length] = '\n';
+   length++;
+
+   return length;
+}
+
+/**
+ * @brief writeLog function.
+ *
+ * @details hands an event to the writer thread.
+ *
+ * @param in: sink, event
+ *
+ * @note Safe to call from any thread. Claims the next ring position and
+ *       copies the event in; only if the writer has fallen a whole ring
+ *       behind does the caller yield until a slot frees up, so no event is
+ *       ever dropped.
+ */
+void writeLog( logSink &sink, const logEvent &event )
+{
+   logRing &ring = *sink.ring;
+   logSlot *slot = NULL;
+   size_t position = ring.enqueuePos.load( memory_order_relaxed );
+   size_t sequence = 0;
+
+   while( true )
+   {
+      slot = &ring.slots[position & ( LOG_RING_SIZE - 1 )];
+      sequence = slot->sequence.load( memory_order_acquire );
+
+      if( sequence == position )
+      {
+         if( ring.enqueuePos.compare_exchange_weak( position, position + 1, memory_order_relaxed ) )
+         {
+            break;
+         }
+      }
+      else if( (long long) ( sequence - position ) < 0 )
+      {
+         sched_yield( );
+         position = ring.enqueuePos.load( memory_order_relaxed );
+      }
+      else
+      {
+         position = ring.enqueuePos.load( memory_order_relaxed );
+      }
+   }
+
+   slot->event = event;
+   slot->sequence.store( position + 1, memory_order_release );
+}
+
+/**
+ * @brief closeLogSink function.
+ *
+ * @details stops the writer thread and closes the log file.
+ *
+ * @param in: sink
+ *
+ * @note Waits for the writer to write out every event already pushed.
+ *       Safe to call on a sink that was never opened.
+ */
+void closeLogSink( logSink &sink )
+{
+   if( sink.ring != NULL )
+   {
+      sink.ring->stopping.store( true, memory_order_release );
+      pthread_join( sink.writer, NULL );
+      delete sink.ring;
+      sink.ring = NULL;
+   }
+
+   if( sink.fout.is_open( ) )
+   {
+      sink.fout.close( );
+   }
+
+   if( sink.trace.is_open( ) )
+   {
+      sink.trace.close( );
+   }
+}
@@ -0,0 +1,168 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file LogSink.h
+ *
+ * @brief Simulator log sink for the CS 446/646 operating system simulator.
+ *
+ * @details The simulation engine reports each event once as a logEvent.
+ *          The sink formats the event into a log line a single time and
+ *          fans it out to the monitor, the log file, or both, so the two
+ *          outputs are always byte-identical.
+ *
+ *          writeLog only copies the event into a lock-free ring. A writer
+ *          thread drains the ring, formats the events in batches and writes
+ *          each batch with one call per destination, so neither formatting
+ *          nor output system calls are on the simulation's timing path.
+ *
+ *          In trace mode the writer stores each event as a fixed-size
+ *          traceRecord in a binary trace file instead of formatting it. The
+ *          file starts with the device name tables, so the simtrace tool
+ *          can render the same text log, or CSV, from the trace later.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include "data.h"
+#include "SimClock.h"
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+enum logEventType
+{
+   SIM_START,
+   PROCESS_PREPARE,
+   PROCESS_START,
+   PROCESS_REMOVE,
+   CPU_START,
+   CPU_END,
+   CPU_PREEMPT,
+   MEMORY_ALLOCATE,
+   MEMORY_ALLOCATED,
+   MEMORY_FAILED,
+   BLOCK_START,
+   BLOCK_END,
+   INPUT_START,
+   INPUT_END,
+   OUTPUT_START,
+   OUTPUT_END,
+   PAGE_FAULT,
+   PAGE_LOADED
+};
+
+// longest formatted log line
+const int LOG_LINE_SIZE = 256;
+
+// events the ring holds, a power of two
+const int LOG_RING_SIZE = 8192;
+
+// events the writer formats into one block
+const int LOG_BATCH = 512;
+
+// how long the writer sleeps when the ring is empty
+const int LOG_IDLE_USEC = 200;
+
+// bumped whenever the layout of a trace file changes
+const unsigned int TRACE_VERSION = 2;
+
+const int TRACE_NAME_SIZE = 32;
+
+const char TRACE_MAGIC[8] = { 'S', 'I', 'M', '0', '4', 'T', 'R', 'C' };
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct logEvent
+{
+   simTime time;
+   int type;
+   int processID;
+   int device;
+   int instance;
+   unsigned int address;
+};
+
+// a trace file is a traceHeader, nameCount traceNames, then the records
+struct traceHeader
+{
+   char magic[8];
+   unsigned int version;
+   unsigned int recordSize;
+   unsigned int nameCount;
+   unsigned int unused;
+};
+
+struct traceName
+{
+   char device[TRACE_NAME_SIZE];
+   char unit[TRACE_NAME_SIZE];
+};
+
+struct traceRecord
+{
+   simTime time;
+   int processID;
+   int instance;
+   unsigned int address;
+   short device;
+   unsigned char type;
+   unsigned char unused;
+};
+
+// a slot's sequence tells producers and the writer whose turn it is
+struct logSlot
+{
+   atomic<size_t> sequence;
+   logEvent event;
+};
+
+struct logRing
+{
+   logSlot slots[LOG_RING_SIZE];
+   atomic<size_t> enqueuePos;
+   size_t dequeuePos;
+   atomic<bool> stopping;
+};
+
+struct logSink
+{
+   bool toMonitor;
+   bool toFile;
+   bool toTrace;
+   ofstream fout;
+   ofstream trace;
+   vector<string> deviceNames;
+   vector<string> unitNames;
+
+   // NULL until openLogSink starts the writer
+   logRing *ring;
+   pthread_t writer;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+bool openLogSink( logSink &sink, configData &fileData, const char tracePath[] );
+
+void writeLog( logSink &sink, const logEvent &event );
+
+int formatLogEvent( logSink &sink, const logEvent &event, char line[] );
+
+void closeLogSink( logSink &sink );
+
+#endif // LOG_SINK_H
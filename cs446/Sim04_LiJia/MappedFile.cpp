@@ -0,0 +1,100 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file MappedFile.cpp
+ *
+ * @brief Read-only memory-mapped file implementation for the CS 446/646
+ *        operating system simulator.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "MappedFile.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief mapFile function.
+ *
+ * @details maps a whole file read-only.
+ *
+ * @param in: path
+ *
+ * @param out: file
+ *
+ * @note Returns false if the file cannot be opened, is empty or cannot be
+ *       mapped; file is left empty then. The kernel is told the file will
+ *       be read front to back.
+ */
+bool mapFile( mappedFile &file, const char path[] )
+{
+   struct stat info;
+   void *data = NULL;
+
+   file.fd = -1;
+   file.data = NULL;
+   file.size = 0;
+
+   file.fd = open( path, O_RDONLY );
+
+   if( file.fd < 0 )
+   {
+      return false;
+   }
+
+   if( ( fstat( file.fd, &info ) != 0 ) || ( info.st_size <= 0 ) )
+   {
+      close( file.fd );
+      file.fd = -1;
+      return false;
+   }
+
+   data = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, file.fd, 0 );
+
+   if( data == MAP_FAILED )
+   {
+      close( file.fd );
+      file.fd = -1;
+      return false;
+   }
+
+   madvise( data, info.st_size, MADV_SEQUENTIAL );
+   file.data = (const char *) data;
+   file.size = info.st_size;
+
+   return true;
+}
+
+/**
+ * @brief unmapFile function.
+ *
+ * @details releases a mapping made by mapFile.
+ *
+ * @param in: file
+ *
+ * @note Safe to call on a file that failed to map.
+ */
+void unmapFile( mappedFile &file )
+{
+   if( file.data != NULL )
+   {
+      munmap( (void *) file.data, file.size );
+   }
+   if( file.fd >= 0 )
+   {
+      close( file.fd );
+   }
+
+   file.fd = -1;
+   file.data = NULL;
+   file.size = 0;
+}
@@ -0,0 +1,42 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file MappedFile.h
+ *
+ * @brief Read-only memory-mapped files for the CS 446/646 operating system
+ *        simulator.
+ *
+ * @details Maps a whole input file into memory so that parsers can walk its
+ *          bytes directly instead of going through a stream.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct mappedFile
+{
+   int fd;
+   const char *data;
+   size_t size;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+bool mapFile( mappedFile &file, const char path[] );
+
+void unmapFile( mappedFile &file );
+
+#endif // MAPPED_FILE_H
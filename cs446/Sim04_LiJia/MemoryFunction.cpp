@@ -48,7 +48,12 @@ using namespace std;
  */
 unsigned int allocateMemory( int prevAddress, int blockSize, int memorySize )
 {
-	unsigned int address = (prevAddress + blockSize) % memorySize;
+	unsigned int address = prevAddress + blockSize;
+
+	if( memorySize > 0 )
+	{
+		address = address % memorySize;
+	}
 
 	return address;
 }
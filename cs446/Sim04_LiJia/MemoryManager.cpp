@@ -0,0 +1,497 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file MemoryManager.cpp
+ *
+ * @brief Memory manager implementation for the CS 446/646 operating system
+ *        simulator.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "MemoryManager.h"
+#include "MemoryFunction.h"
+#include "SimClock.h"
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief findMemoryPolicy function.
+ *
+ * @details maps a "Memory Allocation Code" value to its policy.
+ *
+ * @param in: code
+ *
+ * @note An empty code is the original MODULO locator. Returns -1 for an
+ *       unknown code.
+ */
+int findMemoryPolicy( const string &code )
+{
+   if( code.empty( ) || code == "MODULO" )
+   {
+      return MODULO_FIT;
+   }
+   if( code == "FIRST" || code == "FF" )
+   {
+      return FIRST_FIT;
+   }
+   if( code == "BEST" || code == "BF" )
+   {
+      return BEST_FIT;
+   }
+   if( code == "NEXT" || code == "NF" )
+   {
+      return NEXT_FIT;
+   }
+   if( code == "BUDDY" )
+   {
+      return BUDDY_FIT;
+   }
+
+   return -1;
+}
+
+/**
+ * @brief initMemory function.
+ *
+ * @details sets up an empty memory of systemSize kbytes.
+ *
+ * @param in: memory, policy, systemSize, blockSize
+ *
+ * @note The buddy system manages the largest power of two of kbytes that
+ *       fits in systemSize and leaves the rest unused.
+ */
+void initMemory( memoryManager &memory, int policy, int systemSize, int blockSize )
+{
+   int order = 0;
+
+   memory.blockSize = blockSize;
+   memory.lastAddress = 0;
+   memory.freeRanges.clear( );
+   memory.rover = 0;
+   memory.buddyFree.clear( );
+   memory.owned.clear( );
+   memory.stats = memoryStats( );
+   memory.stats.policy = policy;
+   memory.stats.total = systemSize;
+
+   if( systemSize <= 0 )
+   {
+      memory.stats.total = 0;
+      return;
+   }
+
+   if( policy == BUDDY_FIT )
+   {
+      while( ( 1LL << ( order + 1 ) ) <= systemSize )
+      {
+         order++;
+      }
+
+      memory.buddyFree.resize( order + 1 );
+      memory.buddyFree[order].insert( 0 );
+      memory.stats.total = 1 << order;
+   }
+   else if( policy != MODULO_FIT )
+   {
+      memory.freeRanges[0] = systemSize;
+   }
+}
+
+/**
+ * @brief largestFree function.
+ *
+ * @details size of the largest free range or buddy block.
+ *
+ * @param in: memory
+ *
+ * @note N/A.
+ */
+static int largestFree( memoryManager &memory )
+{
+   map<int, int>::iterator range;
+   int order = 0;
+   int largest = 0;
+
+   if( memory.stats.policy == BUDDY_FIT )
+   {
+      for( order = (int) memory.buddyFree.size( ) - 1; order >= 0; order-- )
+      {
+         if( !memory.buddyFree[order].empty( ) )
+         {
+            return 1 << order;
+         }
+      }
+      return 0;
+   }
+
+   for( range = memory.freeRanges.begin( ); range != memory.freeRanges.end( ); range++ )
+   {
+      largest = max( largest, range->second );
+   }
+
+   return largest;
+}
+
+/**
+ * @brief fitBlock function.
+ *
+ * @details picks the free range a first, best or next fit allocation of
+ *          size kbytes comes from.
+ *
+ * @param in: memory, size
+ *
+ * @note Returns freeRanges.end( ) if no range is big enough. Next fit
+ *       searches from the first range at or after the rover and wraps.
+ */
+static map<int, int>::iterator fitBlock( memoryManager &memory, int size )
+{
+   map<int, int>::iterator range;
+   map<int, int>::iterator best = memory.freeRanges.end( );
+
+   if( memory.stats.policy == NEXT_FIT )
+   {
+      for( range = memory.freeRanges.lower_bound( memory.rover ); range != memory.freeRanges.end( ); range++ )
+      {
+         if( range->second >= size )
+         {
+            return range;
+         }
+      }
+
+      for( range = memory.freeRanges.begin( ); ( range != memory.freeRanges.end( ) ) && ( range->first < memory.rover ); range++ )
+      {
+         if( range->second >= size )
+         {
+            return range;
+         }
+      }
+
+      return memory.freeRanges.end( );
+   }
+
+   for( range = memory.freeRanges.begin( ); range != memory.freeRanges.end( ); range++ )
+   {
+      if( range->second < size )
+      {
+         continue;
+      }
+
+      if( memory.stats.policy == FIRST_FIT )
+      {
+         return range;
+      }
+
+      if( ( best == memory.freeRanges.end( ) ) || ( range->second < best->second ) )
+      {
+         best = range;
+      }
+   }
+
+   return best;
+}
+
+/**
+ * @brief allocateBuddy function.
+ *
+ * @details takes a buddy block of at least size kbytes, splitting larger
+ *          blocks as needed.
+ *
+ * @param in: memory, size
+ *
+ * @param out: block
+ *
+ * @note The lowest free block of the smallest order that fits is used.
+ *       Returns false if there is none.
+ */
+static bool allocateBuddy( memoryManager &memory, int size, memoryBlock &block )
+{
+   int order = 0;
+   int want = 0;
+
+   while( ( want < (int) memory.buddyFree.size( ) ) && ( ( 1 << want ) < size ) )
+   {
+      want++;
+   }
+
+   for( order = want; order < (int) memory.buddyFree.size( ); order++ )
+   {
+      if( !memory.buddyFree[order].empty( ) )
+      {
+         break;
+      }
+   }
+
+   if( order >= (int) memory.buddyFree.size( ) )
+   {
+      return false;
+   }
+
+   block.address = *memory.buddyFree[order].begin( );
+   memory.buddyFree[order].erase( memory.buddyFree[order].begin( ) );
+
+   while( order > want )
+   {
+      order--;
+      memory.buddyFree[order].insert( block.address + ( 1 << order ) );
+   }
+
+   block.size = 1 << want;
+   return true;
+}
+
+/**
+ * @brief allocateBlock function.
+ *
+ * @details allocates one block of memory to a process.
+ *
+ * @param in: memory, owner (process ID)
+ *
+ * @param out: address
+ *
+ * @note The MODULO policy is the original allocateMemory locator and never
+ *       fails. The other policies return false when no free range fits,
+ *       which the statistics count as a failure. The latency covers the
+ *       allocator only, not the fragmentation figures taken after it.
+ */
+bool allocateBlock( memoryManager &memory, int owner, unsigned int &address )
+{
+   memoryStats &stats = memory.stats;
+   map<int, int>::iterator range;
+   memoryBlock block;
+   long long started = readMonotonic( );
+   long long latency = 0;
+   bool found = false;
+   int freeTotal = 0;
+   double fragmentation = 0;
+
+   if( stats.policy == MODULO_FIT )
+   {
+      address = memory.lastAddress;
+      memory.lastAddress = allocateMemory( memory.lastAddress, memory.blockSize, stats.total );
+      found = true;
+   }
+   else if( memory.blockSize > 0 )
+   {
+      block.size = memory.blockSize;
+
+      if( stats.policy == BUDDY_FIT )
+      {
+         found = allocateBuddy( memory, memory.blockSize, block );
+      }
+      else
+      {
+         range = fitBlock( memory, block.size );
+         found = ( range != memory.freeRanges.end( ) );
+
+         if( found )
+         {
+            block.address = range->first;
+
+            if( range->second > block.size )
+            {
+               memory.freeRanges[range->first + block.size] = range->second - block.size;
+            }
+
+            memory.freeRanges.erase( range );
+            memory.rover = block.address + block.size;
+         }
+      }
+
+      if( found )
+      {
+         address = block.address;
+         memory.owned[owner].push_back( block );
+         stats.inUse = stats.inUse + block.size;
+         stats.peakUse = max( stats.peakUse, stats.inUse );
+         stats.handedOut = stats.handedOut + block.size;
+         stats.internalWaste = stats.internalWaste + block.size - memory.blockSize;
+      }
+   }
+
+   latency = readMonotonic( ) - started;
+   stats.allocations++;
+   stats.totalLatency = stats.totalLatency + latency;
+   stats.maxLatency = max( stats.maxLatency, latency );
+
+   if( !found )
+   {
+      stats.failures++;
+   }
+
+   if( stats.policy != MODULO_FIT )
+   {
+      freeTotal = stats.total - stats.inUse;
+      fragmentation = ( freeTotal > 0 ) ? 1.0 - (double) largestFree( memory ) / freeTotal : 0;
+      stats.totalFragmentation = stats.totalFragmentation + fragmentation;
+      stats.maxFragmentation = max( stats.maxFragmentation, fragmentation );
+   }
+
+   return found;
+}
+
+/**
+ * @brief releaseBlocks function.
+ *
+ * @details frees every block a process holds.
+ *
+ * @param in: memory, owner (process ID)
+ *
+ * @note Freed ranges are merged with free neighbours; freed buddy blocks
+ *       are merged with their buddies as far up as they go.
+ */
+void releaseBlocks( memoryManager &memory, int owner )
+{
+   unordered_map< int, vector<memoryBlock> >::iterator held = memory.owned.find( owner );
+   map<int, int>::iterator range;
+   map<int, int>::iterator next;
+   size_t index = 0;
+   int address = 0;
+   int size = 0;
+   int order = 0;
+   int buddy = 0;
+
+   if( held == memory.owned.end( ) )
+   {
+      return;
+   }
+
+   for( index = 0; index < held->second.size( ); index++ )
+   {
+      address = held->second[index].address;
+      size = held->second[index].size;
+      memory.stats.inUse = memory.stats.inUse - size;
+
+      if( memory.stats.policy == BUDDY_FIT )
+      {
+         order = 0;
+
+         while( ( 1 << order ) < size )
+         {
+            order++;
+         }
+
+         while( order + 1 < (int) memory.buddyFree.size( ) )
+         {
+            buddy = address ^ ( 1 << order );
+
+            if( memory.buddyFree[order].erase( buddy ) == 0 )
+            {
+               break;
+            }
+
+            address = min( address, buddy );
+            order++;
+         }
+
+         memory.buddyFree[order].insert( address );
+         continue;
+      }
+
+      range = memory.freeRanges.insert( make_pair( address, size ) ).first;
+      next = range;
+      next++;
+
+      if( ( next != memory.freeRanges.end( ) ) && ( next->first == range->first + range->second ) )
+      {
+         range->second = range->second + next->second;
+         memory.freeRanges.erase( next );
+      }
+
+      if( range != memory.freeRanges.begin( ) )
+      {
+         next = range;
+         range--;
+
+         if( range->first + range->second == next->first )
+         {
+            range->second = range->second + next->second;
+            memory.freeRanges.erase( next );
+         }
+      }
+   }
+
+   memory.owned.erase( held );
+}
+
+/**
+ * @brief memoryPolicyName function.
+ *
+ * @details config code of a memory policy, for the summary.
+ *
+ * @param in: policy
+ *
+ * @note N/A.
+ */
+const char *memoryPolicyName( int policy )
+{
+   switch( policy )
+   {
+      case FIRST_FIT:
+         return "FIRST";
+
+      case BEST_FIT:
+         return "BEST";
+
+      case NEXT_FIT:
+         return "NEXT";
+
+      case BUDDY_FIT:
+         return "BUDDY";
+
+      default:
+         return "MODULO";
+   }
+}
+
+/**
+ * @brief printMemorySummary function.
+ *
+ * @details prints the memory manager figures of a run.
+ *
+ * @param in: stats
+ *
+ * @note Printed by the run summary for every policy but MODULO, which
+ *       neither frees nor fails.
+ */
+void printMemorySummary( memoryStats &stats )
+{
+   streamsize oldPrecision = cout.precision( );
+   double meanLatency = 0;
+   double meanFragmentation = 0;
+   double failureRate = 0;
+
+   if( stats.allocations > 0 )
+   {
+      meanLatency = (double) stats.totalLatency / stats.allocations / NSEC_PER_USEC;
+      meanFragmentation = stats.totalFragmentation / stats.allocations;
+      failureRate = (double) stats.failures / stats.allocations;
+   }
+
+   cout << fixed << setprecision(3);
+   cout << "Memory allocation: " << memoryPolicyName( stats.policy ) << ", " << stats.total << " kbytes" << endl;
+   cout << "Memory allocations: " << stats.allocations << ", failed " << stats.failures
+        << " (rate " << failureRate << ")" << endl;
+   cout << "Memory allocation latency mean/max (usec): " << meanLatency << " / "
+        << (double) stats.maxLatency / NSEC_PER_USEC << endl;
+   cout << "Memory fragmentation mean/max: " << meanFragmentation << " / " << stats.maxFragmentation << endl;
+   cout << "Memory peak use (kbytes): " << stats.peakUse;
+
+   if( ( stats.policy == BUDDY_FIT ) && ( stats.handedOut > 0 ) )
+   {
+      cout << ", internal fragmentation " << (double) stats.internalWaste / stats.handedOut;
+   }
+   cout << endl;
+
+   cout.unsetf( ios::floatfield );
+   cout.precision( oldPrecision );
+}
@@ -0,0 +1,124 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file MemoryManager.h
+ *
+ * @brief Memory manager for the CS 446/646 operating system simulator.
+ *
+ * @details Hands out blocks of "Memory block size" kbytes from the
+ *          "System memory" kbytes for M(allocate) operations and takes a
+ *          process's blocks back when it ends. The policy comes from the
+ *          "Memory Allocation Code" config line:
+ *
+ *          MODULO - the original locator: each block starts where the last
+ *                   one ended, wrapping at the end of memory; nothing is
+ *                   freed and allocation never fails (the default)
+ *          FIRST  - first fit, the lowest free range that is big enough
+ *          BEST   - best fit, the smallest free range that is big enough
+ *          NEXT   - next fit, first fit starting where the last search
+ *                   stopped
+ *          BUDDY  - binary buddy system over the largest power of two of
+ *                   kbytes that fits in memory
+ *
+ *          Addresses are kbyte offsets, as the original locator's were.
+ *          Free ranges are kept in an ordered map keyed by address and
+ *          merged with their neighbours when freed; the buddy system keeps
+ *          one set of free blocks per power of two.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef MEMORY_MANAGER_H
+#define MEMORY_MANAGER_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+enum memoryPolicy
+{
+   MODULO_FIT,
+   FIRST_FIT,
+   BEST_FIT,
+   NEXT_FIT,
+   BUDDY_FIT
+};
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct memoryBlock
+{
+   int address;
+   int size;
+};
+
+struct memoryStats
+{
+   int policy;
+   int total;
+   long long allocations;
+   long long failures;
+
+   // allocator run time, in nanoseconds
+   long long totalLatency;
+   long long maxLatency;
+
+   // external fragmentation, 1 - largest free range / free memory, taken
+   // after every allocation
+   double totalFragmentation;
+   double maxFragmentation;
+
+   // kbytes handed out, and how many of them buddy rounding added
+   long long handedOut;
+   long long internalWaste;
+
+   int inUse;
+   int peakUse;
+};
+
+struct memoryManager
+{
+   int blockSize;
+   unsigned int lastAddress;
+
+   // fit policies: free ranges by address, and where next fit resumes
+   map<int, int> freeRanges;
+   int rover;
+
+   // buddy policy: free blocks of 2^order kbytes by order
+   vector< set<int> > buddyFree;
+
+   // blocks held by each process, by process ID
+   unordered_map< int, vector<memoryBlock> > owned;
+
+   memoryStats stats;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+int findMemoryPolicy( const string &code );
+
+void initMemory( memoryManager &memory, int policy, int systemSize, int blockSize );
+
+bool allocateBlock( memoryManager &memory, int owner, unsigned int &address );
+
+void releaseBlocks( memoryManager &memory, int owner );
+
+const char *memoryPolicyName( int policy );
+
+void printMemorySummary( memoryStats &stats );
+
+#endif // MEMORY_MANAGER_H
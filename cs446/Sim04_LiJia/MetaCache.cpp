@@ -0,0 +1,472 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file MetaCache.cpp
+ *
+ * @brief Compiled meta-data cache implementation for the CS 446/646
+ *        operating system simulator.
+ *
+ * @details A .mdb file is a metaCacheHeader followed by opCount cachedOp
+ *          records, written in the byte order of the machine. It is written
+ *          to a temporary file and renamed into place, so a run never maps a
+ *          half written cache.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "MetaCache.h"
+#include "Simulator.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+static const char MDB_MAGIC[8] = { 'S', 'I', 'M', '0', '4', 'M', 'D', 'B' };
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief hashBytes function.
+ *
+ * @details 64 bit FNV-1a hash of a byte range.
+ *
+ * @param in: data, size
+ *
+ * @note N/A.
+ */
+static unsigned long long hashBytes( const char *data, size_t size )
+{
+   unsigned long long hash = 14695981039346656037ULL;
+   size_t index = 0;
+
+   for( index = 0; index < size; index++ )
+   {
+      hash = ( hash ^ (unsigned char) data[index] ) * 1099511628211ULL;
+   }
+
+   return hash;
+}
+
+/**
+ * @brief metaCachePath function.
+ *
+ * @details names the .mdb file of a meta-data file.
+ *
+ * @param in: sourcePath
+ *
+ * @note A trailing .mdf is replaced, any other name gets .mdb appended.
+ */
+string metaCachePath( const char sourcePath[] )
+{
+   string path = sourcePath;
+
+   if( ( path.size( ) > 4 ) && ( path.compare( path.size( ) - 4, 4, ".mdf" ) == 0 ) )
+   {
+      path.erase( path.size( ) - 4 );
+   }
+
+   return path + ".mdb";
+}
+
+/**
+ * @brief resolveCacheNames function.
+ *
+ * @details looks up the component names of a cache in the config.
+ *
+ * @param in: header, fileData
+ *
+ * @param out: cache
+ *
+ * @note Returns false if a name is an I/O device the config does not have.
+ */
+static bool resolveCacheNames( metaCache &cache, const metaCacheHeader *header, configData &fileData )
+{
+   int index = 0;
+
+   cache.devices[0] = -1;
+   cache.cycleTimes[0] = 0;
+
+   for( index = 1; index < (int) header->nameCount; index++ )
+   {
+      cache.devices[index] = findComponent( fileData, header->names[index].name );
+      cache.cycleTimes[index] = 0;
+
+      if( cache.devices[index] >= 0 )
+      {
+         cache.cycleTimes[index] = (simTime) fileData.cycleData[cache.devices[index]].time * USEC_PER_MSEC;
+      }
+      else if( header->names[index].io )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/**
+ * @brief loadMetaCache function.
+ *
+ * @details maps the .mdb file of a meta-data file if it is still current.
+ *
+ * @param in: fileData, sourcePath
+ *
+ * @param out: cache
+ *
+ * @note Returns false if there is no usable cache: it is missing, of
+ *       another version, cut short, out of date, or names an I/O device
+ *       the config does not have, whose typo message only the text parser
+ *       gives. A cache that is only out of date by its modification time
+ *       gets the new time written into its header.
+ */
+bool loadMetaCache( metaCache &cache, configData &fileData, const char sourcePath[] )
+{
+   string path = metaCachePath( sourcePath );
+   struct stat info;
+   const metaCacheHeader *header = NULL;
+   metaCacheHeader fresh;
+   mappedFile source;
+   bool current = false;
+   int fd = -1;
+
+   cache.ops = NULL;
+   cache.count = 0;
+
+   if( ( stat( sourcePath, &info ) != 0 ) || ( mapFile( cache.file, path.c_str( ) ) == false ) )
+   {
+      return false;
+   }
+
+   header = (const metaCacheHeader *) cache.file.data;
+
+   if( ( cache.file.size < sizeof( metaCacheHeader ) ) ||
+       ( memcmp( header->magic, MDB_MAGIC, sizeof( MDB_MAGIC ) ) != 0 ) ||
+       ( header->version != MDB_VERSION ) ||
+       ( header->recordSize != sizeof( cachedOp ) ) ||
+       ( header->nameCount == 0 ) || ( header->nameCount > (unsigned int) MDB_NAMES ) ||
+       ( cache.file.size != sizeof( metaCacheHeader ) + header->opCount * sizeof( cachedOp ) ) ||
+       ( header->sourceSize != (unsigned long long) info.st_size ) )
+   {
+      unmapFile( cache.file );
+      return false;
+   }
+
+   current = ( header->sourceSeconds == info.st_mtim.tv_sec ) &&
+             ( header->sourceNanoseconds == info.st_mtim.tv_nsec );
+
+   if( !current && ( mapFile( source, sourcePath ) == true ) )
+   {
+      current = ( hashBytes( source.data, source.size ) == header->sourceHash );
+      unmapFile( source );
+
+      if( current )
+      {
+         fresh = *header;
+         fresh.sourceSeconds = info.st_mtim.tv_sec;
+         fresh.sourceNanoseconds = info.st_mtim.tv_nsec;
+         fd = open( path.c_str( ), O_WRONLY );
+
+         if( fd >= 0 )
+         {
+            pwrite( fd, &fresh, sizeof( fresh ), 0 );
+            close( fd );
+         }
+      }
+   }
+
+   if( !current )
+   {
+      unmapFile( cache.file );
+      return false;
+   }
+
+   if( resolveCacheNames( cache, header, fileData ) == false )
+   {
+      unmapFile( cache.file );
+      return false;
+   }
+
+   cache.shared = false;
+   cache.ops = (const cachedOp *) ( cache.file.data + sizeof( metaCacheHeader ) );
+   cache.count = header->opCount;
+
+   return true;
+}
+
+/**
+ * @brief shareMetaCache function.
+ *
+ * @details resolves a cache another config already mapped against this one.
+ *
+ * @param in: source, fileData
+ *
+ * @param out: cache
+ *
+ * @note The records stay in the source's mapping, which must outlive the
+ *       shared cache; unloading the shared cache leaves it mapped. Returns
+ *       false, as loadMetaCache does, if the config lacks an I/O device.
+ */
+bool shareMetaCache( metaCache &cache, const metaCache &source, configData &fileData )
+{
+   cache.ops = NULL;
+   cache.count = 0;
+
+   if( ( source.ops == NULL ) ||
+       ( resolveCacheNames( cache, (const metaCacheHeader *) source.file.data, fileData ) == false ) )
+   {
+      return false;
+   }
+
+   cache.shared = true;
+   cache.ops = source.ops;
+   cache.count = source.count;
+
+   return true;
+}
+
+/**
+ * @brief profileMetaCache function.
+ *
+ * @details totals the cycles of each component name.
+ *
+ * @param in: cache
+ *
+ * @param out: profile
+ *
+ * @note An application runs from A(start) to A(end) or the next A(start),
+ *       as the engine admits it; operations outside one are not counted.
+ *       Times the cache's cycle times, the totals are the time the
+ *       operations of the applications take.
+ */
+void profileMetaCache( const metaCache &cache, metaProfile &profile )
+{
+   size_t index = 0;
+   bool inApplication = false;
+
+   profile = metaProfile( );
+
+   for( index = 0; index < cache.count; index++ )
+   {
+      const cachedOp &op = cache.ops[index];
+
+      if( op.code == OP_APP_START )
+      {
+         profile.applications++;
+         inApplication = true;
+      }
+      else if( op.code == OP_APP_END )
+      {
+         inApplication = false;
+      }
+      else if( inApplication && ( ( op.code == OP_INPUT ) || ( op.code == OP_OUTPUT ) ) )
+      {
+         profile.ioCycles[op.name] = profile.ioCycles[op.name] + op.cycles;
+      }
+      else if( inApplication )
+      {
+         profile.cpuCycles[op.name] = profile.cpuCycles[op.name] + op.cycles;
+      }
+   }
+}
+
+/**
+ * @brief resolveCachedOp function.
+ *
+ * @details compiles a cached record against the loaded config.
+ *
+ * @param in: cache, index
+ *
+ * @param out: op
+ *
+ * @note Gives the same opRecord parseMetaOp would, including OP_SKIP for
+ *       processing and memory operations the config has no cycle time for.
+ */
+void resolveCachedOp( const metaCache &cache, size_t index, opRecord &op )
+{
+   const cachedOp &cached = cache.ops[index];
+
+   op.code = cached.code;
+   op.device = cache.devices[cached.name];
+   op.duration = cached.cycles * cache.cycleTimes[cached.name];
+
+   if( ( op.device < 0 ) &&
+       ( ( op.code == OP_RUN ) || ( op.code == OP_ALLOCATE ) || ( op.code == OP_BLOCK ) ) )
+   {
+      op.code = OP_SKIP;
+   }
+}
+
+/**
+ * @brief unloadMetaCache function.
+ *
+ * @details releases a cache mapped by loadMetaCache.
+ *
+ * @param in: cache
+ *
+ * @note Safe to call on a cache that did not load. A shared cache only
+ *       lets go of its source's records.
+ */
+void unloadMetaCache( metaCache &cache )
+{
+   if( ( cache.ops != NULL ) && !cache.shared )
+   {
+      unmapFile( cache.file );
+   }
+
+   cache.ops = NULL;
+   cache.count = 0;
+}
+
+/**
+ * @brief beginMetaCache function.
+ *
+ * @details starts collecting records for a new .mdb file.
+ *
+ * @param in: writer
+ *
+ * @note N/A.
+ */
+void beginMetaCache( metaCacheWriter &writer )
+{
+   cachedName none = cachedName( );
+
+   writer.usable = true;
+   writer.ops.clear( );
+   writer.names.clear( );
+   writer.names.push_back( none );
+}
+
+/**
+ * @brief addMetaCacheOp function.
+ *
+ * @details records one parsed operation for the .mdb file.
+ *
+ * @param in: writer, fileData, op, cycles
+ *
+ * @note The component is kept by its config name so that another config
+ *       can look it up again. An OP_SKIP record has lost which operation it
+ *       was, and too many or too long names do not fit the header; any of
+ *       these makes the meta-data uncachable.
+ */
+void addMetaCacheOp( metaCacheWriter &writer, configData &fileData, const opRecord &op, int cycles )
+{
+   cachedOp cached = cachedOp( );
+   cachedName entry = cachedName( );
+   size_t index = 0;
+
+   if( !writer.usable )
+   {
+      return;
+   }
+
+   if( ( op.code == OP_SKIP ) ||
+       ( ( op.device >= 0 ) && ( fileData.cycleData[op.device].componentName.size( ) >= (size_t) MDB_NAME_SIZE ) ) )
+   {
+      writer.usable = false;
+      return;
+   }
+
+   cached.cycles = cycles;
+   cached.code = op.code;
+   cached.name = 0;
+
+   if( op.device >= 0 )
+   {
+      strncpy( entry.name, fileData.cycleData[op.device].componentName.c_str( ), MDB_NAME_SIZE - 1 );
+      entry.io = ( op.code == OP_INPUT ) || ( op.code == OP_OUTPUT );
+
+      for( index = 1; index < writer.names.size( ); index++ )
+      {
+         if( ( strcmp( writer.names[index].name, entry.name ) == 0 ) &&
+             ( writer.names[index].io == entry.io ) )
+         {
+            break;
+         }
+      }
+
+      if( index == writer.names.size( ) )
+      {
+         if( index == (size_t) MDB_NAMES )
+         {
+            writer.usable = false;
+            return;
+         }
+
+         writer.names.push_back( entry );
+      }
+
+      cached.name = index;
+   }
+
+   writer.ops.push_back( cached );
+}
+
+/**
+ * @brief saveMetaCache function.
+ *
+ * @details writes the collected records to the .mdb file of a meta-data file.
+ *
+ * @param in: writer, sourcePath, source (the mapped meta-data file)
+ *
+ * @note Only called once the whole meta-data parsed, so a file with an
+ *       error keeps giving its message. Failing to write the cache, for
+ *       example in a read-only directory, is not an error.
+ */
+void saveMetaCache( metaCacheWriter &writer, const char sourcePath[], const mappedFile &source )
+{
+   string path = metaCachePath( sourcePath );
+   ostringstream temporary;
+   metaCacheHeader header = metaCacheHeader( );
+   struct stat info;
+   ofstream fout;
+
+   if( !writer.usable || ( fstat( source.fd, &info ) != 0 ) )
+   {
+      return;
+   }
+
+   memcpy( header.magic, MDB_MAGIC, sizeof( MDB_MAGIC ) );
+   header.version = MDB_VERSION;
+   header.recordSize = sizeof( cachedOp );
+   header.opCount = writer.ops.size( );
+   header.sourceSize = source.size;
+   header.sourceSeconds = info.st_mtim.tv_sec;
+   header.sourceNanoseconds = info.st_mtim.tv_nsec;
+   header.sourceHash = hashBytes( source.data, source.size );
+   header.nameCount = writer.names.size( );
+   memcpy( header.names, &writer.names[0], writer.names.size( ) * sizeof( cachedName ) );
+
+   temporary << path << "." << getpid( );
+   fout.open( temporary.str( ).c_str( ), ios::binary );
+
+   if( !fout.is_open( ) )
+   {
+      return;
+   }
+
+   fout.write( (const char *) &header, sizeof( header ) );
+
+   if( !writer.ops.empty( ) )
+   {
+      fout.write( (const char *) &writer.ops[0], writer.ops.size( ) * sizeof( cachedOp ) );
+   }
+
+   fout.close( );
+
+   if( fout.fail( ) || ( rename( temporary.str( ).c_str( ), path.c_str( ) ) != 0 ) )
+   {
+      remove( temporary.str( ).c_str( ) );
+   }
+}
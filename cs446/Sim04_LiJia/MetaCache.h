@@ -0,0 +1,136 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file MetaCache.h
+ *
+ * @brief Compiled meta-data cache for the CS 446/646 operating system
+ *        simulator.
+ *
+ * @details The first time a meta-data file is read, its operations are also
+ *          written to a binary .mdb file next to it. Later runs map the .mdb
+ *          file and feed its records to the engine directly instead of
+ *          parsing the text again.
+ *
+ *          Records keep the cycle count and the name of the component, not
+ *          the duration and config entry, so one .mdb file serves every
+ *          config; the names are looked up once when the cache is loaded.
+ *          The header keeps the size, modification time and FNV-1a hash of
+ *          the meta-data file. A cache whose time no longer matches is only
+ *          used if the hash still does.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef META_CACHE_H
+#define META_CACHE_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include "data.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+// bumped whenever the layout of a .mdb file changes
+const unsigned int MDB_VERSION = 2;
+
+// component names one .mdb file can hold, entry 0 is "no component"
+const int MDB_NAMES = 256;
+
+const int MDB_NAME_SIZE = 31;
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct cachedOp
+{
+   int cycles;
+   unsigned char code;
+   unsigned char name;
+   unsigned char unused[2];
+};
+
+struct cachedName
+{
+   char name[MDB_NAME_SIZE];
+
+   // set for I/O devices, which must be in the config
+   unsigned char io;
+};
+
+struct metaCacheHeader
+{
+   char magic[8];
+   unsigned int version;
+   unsigned int recordSize;
+   unsigned long long opCount;
+   unsigned long long sourceSize;
+   long long sourceSeconds;
+   long long sourceNanoseconds;
+   unsigned long long sourceHash;
+   unsigned int nameCount;
+   unsigned int unused;
+   cachedName names[MDB_NAMES];
+};
+
+struct metaCache
+{
+   mappedFile file;
+   const cachedOp *ops;
+   size_t count;
+
+   // set when the records belong to another cache's mapping
+   bool shared;
+
+   // config entry and time per cycle of each name
+   int devices[MDB_NAMES];
+   simTime cycleTimes[MDB_NAMES];
+};
+
+// cycle totals of a cached meta-data file by component name, counting
+// only the operations inside applications, which are the ones that run
+struct metaProfile
+{
+   long long applications;
+
+   // cycles of the processing and memory operations, and of the I/O
+   long long cpuCycles[MDB_NAMES];
+   long long ioCycles[MDB_NAMES];
+};
+
+struct metaCacheWriter
+{
+   bool usable;
+   vector<cachedOp> ops;
+   vector<cachedName> names;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+string metaCachePath( const char sourcePath[] );
+
+bool loadMetaCache( metaCache &cache, configData &fileData, const char sourcePath[] );
+
+bool shareMetaCache( metaCache &cache, const metaCache &source, configData &fileData );
+
+void profileMetaCache( const metaCache &cache, metaProfile &profile );
+
+void resolveCachedOp( const metaCache &cache, size_t index, opRecord &op );
+
+void unloadMetaCache( metaCache &cache );
+
+void beginMetaCache( metaCacheWriter &writer );
+
+void addMetaCacheOp( metaCacheWriter &writer, configData &fileData, const opRecord &op, int cycles );
+
+void saveMetaCache( metaCacheWriter &writer, const char sourcePath[], const mappedFile &source );
+
+#endif // META_CACHE_H
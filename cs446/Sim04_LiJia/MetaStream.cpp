@@ -0,0 +1,546 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file MetaStream.cpp
+ *
+ * @brief Meta-data tokenizer and operation feed implementation for the
+ *        CS 446/646 operating system simulator.
+ *
+ * @details The stream feed's queue is a ring of operations guarded by one
+ *          mutex. Both sides move up to FEED_BATCH operations per lock so
+ *          the lock is not taken once per operation.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "MetaStream.h"
+#include "Simulator.h"
+#include <iostream>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief parseMetaOp function.
+ *
+ * @details tokenizes the next meta-data operation in [next, end) and
+ *          compiles it.
+ *
+ * @param in: fileData, next, end, final
+ *
+ * @param out: next, op, cycles
+ *
+ * @note Returns META_OP and moves next past the operation, META_END at the
+ *       end of the meta-data, META_ERROR after printing what is wrong, or
+ *       META_MORE if the range stops inside the operation and final is
+ *       false. With final set, the range is the rest of the input.
+ *       Processing and memory operations the config has no cycle time for
+ *       compile to OP_SKIP.
+ */
+int parseMetaOp( configData &fileData, const char *&next, const char *end, bool final, opRecord &op, int &cycles )
+{
+   const char *cursor = next;
+   const char *opening = NULL;
+   const char *closing = NULL;
+   char code = '\0';
+   char description[30];
+   int length = 0;
+
+   cycles = 0;
+
+   while( ( cursor < end ) && ( ( *cursor == ' ' ) || ( *cursor == '\n' ) || ( *cursor == '\r' ) || ( *cursor == '\t' ) ) )
+      cursor++;
+
+   if( cursor == end )
+   {
+      next = cursor;
+      return final ? META_END : META_MORE;
+   }
+
+   if( *cursor == 'E' )
+   {
+      return META_END;
+   }
+
+   code = *cursor;
+
+   if( ( code != 'S' ) && ( code != 'A' ) && ( code != 'M' ) &&
+       ( code != 'P' ) && ( code != 'I' ) && ( code != 'O' ) )
+   {
+      cout << "In the metadata file, you either did not enter a metadata code or the code is invalid.\n";
+      return META_ERROR;
+   }
+
+   opening = (const char *) memchr( cursor, '(', end - cursor );
+   closing = ( opening == NULL ) ? NULL : (const char *) memchr( opening, ')', end - opening );
+
+   if( ( closing == NULL ) && !final && ( end - cursor < 1000 ) )
+   {
+      return META_MORE;
+   }
+
+   length = ( closing == NULL ) ? 0 : closing - opening - 1;
+   op.code = OP_SKIP;
+   op.device = -1;
+
+   if( ( closing != NULL ) && ( length < (int) sizeof( description ) ) )
+   {
+      memcpy( description, opening + 1, length );
+      description[length] = '\0';
+
+      if( ( code == 'S' ) || ( code == 'A' ) )
+      {
+         if( strcmp( "start", description ) == 0 )
+         {
+            op.code = ( code == 'A' ) ? OP_APP_START : OP_SYSTEM;
+         }
+         else if( strcmp( "end", description ) == 0 )
+         {
+            op.code = ( code == 'A' ) ? OP_APP_END : OP_SYSTEM;
+         }
+      }
+      else if( code == 'P' )
+      {
+         if( strcmp( "run", description ) == 0 )
+         {
+            op.code = OP_RUN;
+            op.device = findComponent( fileData, "Processor" );
+         }
+      }
+      else if( code == 'M' )
+      {
+         if( strcmp( "allocate", description ) == 0 )
+         {
+            op.code = OP_ALLOCATE;
+         }
+         else if( strcmp( "block", description ) == 0 )
+         {
+            op.code = OP_BLOCK;
+         }
+         op.device = findComponent( fileData, "Memory" );
+      }
+      else
+      {
+         op.device = findComponent( fileData, description );
+
+         if( op.device >= 0 )
+         {
+            op.code = ( code == 'I' ) ? OP_INPUT : OP_OUTPUT;
+         }
+      }
+   }
+
+   if( op.code == OP_SKIP )
+   {
+      cout << "Sorry, either you made a typo or you forgot to enter the description\n";
+      return META_ERROR;
+   }
+
+   cursor = closing + 1;
+
+   while( ( cursor < end ) && ( *cursor == ' ' ) )
+      cursor++;
+
+   if( ( cursor == end ) && !final )
+   {
+      return META_MORE;
+   }
+
+   if( ( cursor < end ) && ( *cursor == '-' ) )
+   {
+      cout << "Invalid negative cycle values in meta-data file.\n";
+      return META_ERROR;
+   }
+   else if( ( cursor == end ) || ( *cursor < '0' ) || ( *cursor > '9' ) )
+   {
+      cout << "You're missing a cycle value in the meta-data file.\n";
+      return META_ERROR;
+   }
+
+   while( ( cursor < end ) && ( *cursor >= '0' ) && ( *cursor <= '9' ) )
+   {
+      cycles = cycles * 10 + ( *cursor - '0' );
+      cursor++;
+   }
+
+   if( cursor == end )
+   {
+      if( !final )
+      {
+         return META_MORE;
+      }
+   }
+   else
+   {
+      // the ';' or '.' after the cycles
+      cursor++;
+   }
+
+   if( ( op.code == OP_RUN ) || ( op.code == OP_ALLOCATE ) || ( op.code == OP_BLOCK ) )
+   {
+      if( op.device < 0 )
+      {
+         op.code = OP_SKIP;
+      }
+   }
+
+   op.duration = 0;
+
+   if( op.device >= 0 )
+   {
+      op.duration = (simTime) cycles * fileData.cycleData[op.device].time * USEC_PER_MSEC;
+   }
+
+   next = cursor;
+   return META_OP;
+}
+
+/**
+ * @brief openBatchFeed function.
+ *
+ * @details feeds the engine from meta-data already read in.
+ *
+ * @param in: feed, ops, residentLimit
+ *
+ * @note N/A.
+ */
+void openBatchFeed( metaFeed &feed, vector<opRecord> &ops, int residentLimit )
+{
+   feed.streaming = false;
+   feed.residentLimit = residentLimit;
+   feed.ops = &ops;
+   feed.cache = NULL;
+   feed.nextOp = 0;
+   feed.fd = -1;
+}
+
+/**
+ * @brief openCachedFeed function.
+ *
+ * @details feeds the engine from a loaded .mdb cache.
+ *
+ * @param in: feed, cache, residentLimit
+ *
+ * @note Records are compiled against the config as they are handed out.
+ */
+void openCachedFeed( metaFeed &feed, metaCache &cache, int residentLimit )
+{
+   feed.streaming = false;
+   feed.residentLimit = residentLimit;
+   feed.ops = NULL;
+   feed.cache = &cache;
+   feed.nextOp = 0;
+   feed.fd = -1;
+}
+
+/**
+ * @brief pushOps function.
+ *
+ * @details adds parsed operations to the stream feed's queue.
+ *
+ * @param in: feed, ops, count
+ *
+ * @note Blocks while the queue is full. Returns false if the engine has
+ *       closed the feed.
+ */
+static bool pushOps( metaFeed &feed, opRecord ops[], int count )
+{
+   int index = 0;
+   bool wasEmpty = false;
+
+   pthread_mutex_lock( &feed.lock );
+
+   while( index < count )
+   {
+      while( ( feed.count == feed.ring.size( ) ) && !feed.cancelled )
+      {
+         pthread_cond_wait( &feed.notFull, &feed.lock );
+      }
+
+      if( feed.cancelled )
+      {
+         pthread_mutex_unlock( &feed.lock );
+         return false;
+      }
+
+      wasEmpty = ( feed.count == 0 );
+
+      while( ( index < count ) && ( feed.count < feed.ring.size( ) ) )
+      {
+         feed.ring[( feed.head + feed.count ) % feed.ring.size( )] = ops[index];
+         feed.count++;
+         index++;
+      }
+
+      if( wasEmpty )
+      {
+         pthread_cond_signal( &feed.notEmpty );
+      }
+   }
+
+   pthread_mutex_unlock( &feed.lock );
+   return true;
+}
+
+/**
+ * @brief parseStream function.
+ *
+ * @details parser thread of a stream feed.
+ *
+ * @param in: arg, the feed
+ *
+ * @note Reads the input in FEED_CHUNK pieces and keeps the unparsed tail of
+ *       each piece for the next one. Skips the header line, then parses
+ *       until the end of the meta-data, an error or the end of the input.
+ */
+static void *parseStream( void *arg )
+{
+   metaFeed &feed = *(metaFeed *) arg;
+   vector<char> buffer( FEED_CHUNK );
+   opRecord batch[FEED_BATCH];
+   int batchCount = 0;
+   int cycles = 0;
+   size_t have = 0;
+   ssize_t got = 0;
+   bool final = false;
+   bool header = true;
+   bool running = true;
+   const char *next = NULL;
+   const char *end = NULL;
+   const char *newline = NULL;
+   int status = META_OP;
+
+   while( running )
+   {
+      if( have == buffer.size( ) )
+      {
+         buffer.resize( buffer.size( ) * 2 );
+      }
+
+      got = read( feed.fd, &buffer[have], buffer.size( ) - have );
+
+      if( got < 0 )
+      {
+         cout << "Could not read the meta-data input\n";
+         break;
+      }
+
+      final = ( got == 0 );
+      have = have + got;
+      next = &buffer[0];
+      end = next + have;
+
+      if( header )
+      {
+         newline = (const char *) memchr( next, '\n', have );
+
+         if( ( newline == NULL ) && !final )
+         {
+            continue;
+         }
+
+         next = ( newline == NULL ) ? end : newline + 1;
+         header = false;
+      }
+
+      do
+      {
+         status = parseMetaOp( *feed.fileData, next, end, final, batch[batchCount], cycles );
+
+         if( status == META_OP )
+         {
+            batchCount++;
+
+            if( batchCount == FEED_BATCH )
+            {
+               running = pushOps( feed, batch, batchCount );
+               batchCount = 0;
+            }
+         }
+      } while( running && ( status == META_OP ) );
+
+      if( ( status == META_END ) || ( status == META_ERROR ) )
+      {
+         running = false;
+      }
+
+      have = end - next;
+      memmove( &buffer[0], next, have );
+   }
+
+   pushOps( feed, batch, batchCount );
+
+   pthread_mutex_lock( &feed.lock );
+   feed.done = true;
+   pthread_cond_signal( &feed.notEmpty );
+   pthread_mutex_unlock( &feed.lock );
+
+   return NULL;
+}
+
+/**
+ * @brief openStreamFeed function.
+ *
+ * @details starts a parser thread that streams the meta-data to the engine.
+ *
+ * @param in: feed, fileData, path, residentLimit
+ *
+ * @note A path of "-" reads standard input. Returns false if the input
+ *       cannot be opened.
+ */
+bool openStreamFeed( metaFeed &feed, configData &fileData, const char path[], int residentLimit )
+{
+   feed.streaming = true;
+   feed.residentLimit = residentLimit;
+   feed.ops = NULL;
+   feed.cache = NULL;
+   feed.nextOp = 0;
+   feed.fileData = &fileData;
+   feed.fd = ( strcmp( path, "-" ) == 0 ) ? 0 : open( path, O_RDONLY );
+
+   if( feed.fd < 0 )
+   {
+      cout << path << " is either an empty metadata file or an invalid filename\n";
+      feed.streaming = false;
+      return false;
+   }
+
+   pthread_mutex_init( &feed.lock, NULL );
+   pthread_cond_init( &feed.notEmpty, NULL );
+   pthread_cond_init( &feed.notFull, NULL );
+   feed.ring.resize( FEED_SIZE );
+   feed.head = 0;
+   feed.count = 0;
+   feed.done = false;
+   feed.cancelled = false;
+   feed.taken.clear( );
+   feed.nextTaken = 0;
+
+   pthread_create( &feed.parser, NULL, parseStream, &feed );
+
+   return true;
+}
+
+/**
+ * @brief nextMetaOp function.
+ *
+ * @details hands the engine the next meta-data operation.
+ *
+ * @param in: feed
+ *
+ * @param out: op
+ *
+ * @note A stream feed takes up to FEED_BATCH operations from the queue at
+ *       once and blocks while the queue is empty. Returns false at the end
+ *       of the meta-data.
+ */
+bool nextMetaOp( metaFeed &feed, opRecord &op )
+{
+   bool wasFull = false;
+
+   if( !feed.streaming && ( feed.cache != NULL ) )
+   {
+      if( feed.nextOp >= feed.cache->count )
+      {
+         return false;
+      }
+
+      resolveCachedOp( *feed.cache, feed.nextOp, op );
+      feed.nextOp++;
+      return true;
+   }
+
+   if( !feed.streaming )
+   {
+      if( ( feed.ops == NULL ) || ( feed.nextOp >= feed.ops->size( ) ) )
+      {
+         return false;
+      }
+
+      op = ( *feed.ops )[feed.nextOp];
+      feed.nextOp++;
+      return true;
+   }
+
+   if( feed.nextTaken == feed.taken.size( ) )
+   {
+      feed.taken.clear( );
+      feed.nextTaken = 0;
+
+      pthread_mutex_lock( &feed.lock );
+
+      while( ( feed.count == 0 ) && !feed.done )
+      {
+         pthread_cond_wait( &feed.notEmpty, &feed.lock );
+      }
+
+      wasFull = ( feed.count == feed.ring.size( ) );
+
+      while( ( feed.count > 0 ) && ( feed.taken.size( ) < (size_t) FEED_BATCH ) )
+      {
+         feed.taken.push_back( feed.ring[feed.head] );
+         feed.head = ( feed.head + 1 ) % feed.ring.size( );
+         feed.count--;
+      }
+
+      if( wasFull )
+      {
+         pthread_cond_signal( &feed.notFull );
+      }
+
+      pthread_mutex_unlock( &feed.lock );
+
+      if( feed.taken.empty( ) )
+      {
+         return false;
+      }
+   }
+
+   op = feed.taken[feed.nextTaken];
+   feed.nextTaken++;
+   return true;
+}
+
+/**
+ * @brief closeFeed function.
+ *
+ * @details stops a stream feed's parser thread and releases the feed.
+ *
+ * @param in: feed
+ *
+ * @note The parser may still be blocked on a full queue if the engine
+ *       stopped early, so it is cancelled before the join.
+ */
+void closeFeed( metaFeed &feed )
+{
+   if( !feed.streaming )
+   {
+      return;
+   }
+
+   pthread_mutex_lock( &feed.lock );
+   feed.cancelled = true;
+   pthread_cond_signal( &feed.notFull );
+   pthread_mutex_unlock( &feed.lock );
+
+   pthread_join( feed.parser, NULL );
+
+   if( feed.fd > 0 )
+   {
+      close( feed.fd );
+   }
+
+   pthread_mutex_destroy( &feed.lock );
+   pthread_cond_destroy( &feed.notEmpty );
+   pthread_cond_destroy( &feed.notFull );
+   feed.streaming = false;
+}
@@ -0,0 +1,118 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file MetaStream.h
+ *
+ * @brief Meta-data tokenizer and operation feed for the CS 446/646
+ *        operating system simulator.
+ *
+ * @details parseMetaOp tokenizes one meta-data operation from a byte range
+ *          and compiles it into an opRecord: its opcode, the config entry of
+ *          its device and its duration. Both the mapped-file reader and the
+ *          streaming parser use it, so no string work is left for the
+ *          simulation engine.
+ *
+ *          A metaFeed hands operations to the simulation engine one at a
+ *          time. A batch feed walks the operations read in by readMetaData,
+ *          or the records of a mapped .mdb cache.
+ *          A stream feed runs a parser thread that reads the meta-data file,
+ *          standard input or a FIFO in chunks and passes operations through
+ *          a bounded queue, so the engine starts on the first process while
+ *          the rest of the file is still being read.
+ *
+ *          Memory stays bounded however many applications the input holds,
+ *          not however long it is: the engine takes each application whole
+ *          when it admits it, since its priority, planned time and page
+ *          references are worked out from all of its operations. At most
+ *          the resident limit's applications, plus the queue, are held at
+ *          once, so a single application must fit in memory.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef META_STREAM_H
+#define META_STREAM_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <pthread.h>
+#include "data.h"
+#include "MetaCache.h"
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+enum metaParseStatus
+{
+   META_OP,
+   META_END,
+   META_MORE,
+   META_ERROR
+};
+
+// operations the stream feed's queue holds
+const int FEED_SIZE = 4096;
+
+// operations moved between the queue and either side at once
+const int FEED_BATCH = 256;
+
+// bytes the stream parser reads at once
+const int FEED_CHUNK = 65536;
+
+// processes prepared at once when streaming, unless --resident says otherwise
+const int STREAM_RESIDENT = 64;
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct metaFeed
+{
+   bool streaming;
+
+   // processes the engine keeps resident at once, no limit if not positive
+   int residentLimit;
+
+   // batch feed, from ops or else from cache
+   vector<opRecord> *ops;
+   metaCache *cache;
+   size_t nextOp;
+
+   // stream feed
+   configData *fileData;
+   int fd;
+   pthread_t parser;
+   pthread_mutex_t lock;
+   pthread_cond_t notEmpty;
+   pthread_cond_t notFull;
+   vector<opRecord> ring;
+   size_t head;
+   size_t count;
+   bool done;
+   bool cancelled;
+
+   // the engine's side of the queue
+   vector<opRecord> taken;
+   size_t nextTaken;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+int parseMetaOp( configData &fileData, const char *&next, const char *end, bool final, opRecord &op, int &cycles );
+
+void openBatchFeed( metaFeed &feed, vector<opRecord> &ops, int residentLimit );
+
+void openCachedFeed( metaFeed &feed, metaCache &cache, int residentLimit );
+
+bool openStreamFeed( metaFeed &feed, configData &fileData, const char path[], int residentLimit );
+
+bool nextMetaOp( metaFeed &feed, opRecord &op );
+
+void closeFeed( metaFeed &feed );
+
+#endif // META_STREAM_H
@@ -0,0 +1,612 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file Pager.cpp
+ *
+ * @brief Demand paging model implementation for the CS 446/646 operating
+ *        system simulator.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "Pager.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+// next reference index of a page that is not referenced again
+static const size_t NEVER = (size_t) -1;
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief findReplacementPolicy function.
+ *
+ * @details maps a "Page Replacement Code" value to its policy.
+ *
+ * @param in: code
+ *
+ * @note An empty code turns paging off. Returns -1 for an unknown code.
+ */
+int findReplacementPolicy( const string &code )
+{
+   if( code.empty( ) )
+   {
+      return NO_PAGING;
+   }
+   if( code == "FIFO" )
+   {
+      return FIFO_REPLACEMENT;
+   }
+   if( code == "LRU" )
+   {
+      return LRU_REPLACEMENT;
+   }
+   if( code == "CLOCK" )
+   {
+      return CLOCK_REPLACEMENT;
+   }
+   if( code == "OPT" )
+   {
+      return OPT_REPLACEMENT;
+   }
+
+   return -1;
+}
+
+/**
+ * @brief initPager function.
+ *
+ * @details sets up empty frames, page tables and TLBs.
+ *
+ * @param in: paging, policy, systemSize, pageSize, tlbSize, cores
+ *
+ * @note Memory left over after the last whole frame is not used.
+ */
+void initPager( pager &paging, int policy, int systemSize, int pageSize, int tlbSize, int cores )
+{
+   int count = ( pageSize > 0 ) ? systemSize / pageSize : 0;
+   int index = 0;
+   pageFrame empty = pageFrame( );
+
+   empty.owner = -1;
+   paging.pageSize = pageSize;
+   paging.frames.assign( max( count, 0 ), empty );
+   paging.freeFrames.clear( );
+   paging.hand = 0;
+   paging.tick = 0;
+   paging.tables.clear( );
+   paging.tlbs.assign( max( cores, 1 ), vector<tlbEntry>( ) );
+   paging.stats = pagingStats( );
+   paging.stats.policy = policy;
+   paging.stats.frames = paging.frames.size( );
+   paging.stats.tlbSize = max( tlbSize, 0 );
+
+   for( index = (int) paging.frames.size( ) - 1; index >= 0; index-- )
+   {
+      paging.freeFrames.push_back( index );
+   }
+}
+
+/**
+ * @brief referenceCount function.
+ *
+ * @details number of page references an operation makes.
+ *
+ * @param in: fileData, op
+ *
+ * @note One per cycle of an M(block) operation, none for anything else.
+ */
+int referenceCount( configData &fileData, const opRecord &op )
+{
+   simTime cycle = 0;
+
+   if( ( op.code != OP_BLOCK ) || ( op.device < 0 ) )
+   {
+      return 0;
+   }
+
+   cycle = fileData.cycleData[op.device].time * USEC_PER_MSEC;
+
+   return ( cycle > 0 ) ? (int) ( op.duration / cycle ) : 0;
+}
+
+/**
+ * @brief planReferences function.
+ *
+ * @details gives a newly admitted process its page table and plans the
+ *          page references its operations will make.
+ *
+ * @param in: paging, fileData, owner (process ID), ops
+ *
+ * @note Each reference only names pages the process will have by then.
+ *       The generator is a 64 bit LCG seeded by the process ID: 60% of
+ *       references stay on the last page, 30% move to a neighbour and 10%
+ *       go anywhere.
+ */
+void planReferences( pager &paging, configData &fileData, int owner, const vector<opRecord> &ops )
+{
+   processPages &table = paging.tables[owner];
+   unsigned long long seed = (unsigned long long) owner * 2654435761ULL + 1;
+   vector<size_t> seen;
+   size_t index = 0;
+   int planned = 1;
+   int last = 0;
+   int count = 0;
+   int pick = 0;
+
+   table.frames.assign( 1, -1 );
+   table.refs.clear( );
+   table.position = 0;
+   table.nextSame.clear( );
+   table.nextRef.clear( );
+
+   for( index = 0; index < ops.size( ); index++ )
+   {
+      if( ops[index].code == OP_ALLOCATE )
+      {
+         planned++;
+      }
+
+      for( count = referenceCount( fileData, ops[index] ); count > 0; count-- )
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         pick = ( seed >> 33 ) % 100;
+
+         if( pick >= 90 )
+         {
+            last = ( seed >> 40 ) % planned;
+         }
+         else if( pick >= 60 )
+         {
+            last = ( pick & 1 ) ? min( last + 1, planned - 1 ) : max( last - 1, 0 );
+         }
+
+         table.refs.push_back( last );
+      }
+   }
+
+   if( paging.stats.policy == OPT_REPLACEMENT )
+   {
+      seen.assign( planned, NEVER );
+      table.nextSame.resize( table.refs.size( ) );
+
+      for( index = table.refs.size( ); index > 0; index-- )
+      {
+         table.nextSame[index - 1] = seen[table.refs[index - 1]];
+         seen[table.refs[index - 1]] = index - 1;
+      }
+
+      table.nextRef = seen;
+   }
+}
+
+/**
+ * @brief addPage function.
+ *
+ * @details adds a page to a process's address space.
+ *
+ * @param in: paging, owner (process ID)
+ *
+ * @note The page gets no frame until it is first referenced. Returns its
+ *       virtual address, a kbyte offset.
+ */
+unsigned int addPage( pager &paging, int owner )
+{
+   processPages &table = paging.tables[owner];
+
+   table.frames.push_back( -1 );
+
+   return ( table.frames.size( ) - 1 ) * paging.pageSize;
+}
+
+/**
+ * @brief completeReference function.
+ *
+ * @details marks a process's next reference, to a resident page, as made.
+ *
+ * @param in: paging, table, frame
+ *
+ * @note N/A.
+ */
+static void completeReference( pager &paging, processPages &table, int frame )
+{
+   paging.frames[frame].lastUse = paging.tick;
+   paging.frames[frame].referenced = true;
+
+   if( paging.stats.policy == OPT_REPLACEMENT )
+   {
+      table.nextRef[table.refs[table.position]] = table.nextSame[table.position];
+   }
+
+   table.position++;
+   paging.stats.references++;
+}
+
+/**
+ * @brief fillTlb function.
+ *
+ * @details puts a translation into a core's TLB.
+ *
+ * @param in: paging, core, entry
+ *
+ * @note A full TLB drops its least recently used entry.
+ */
+static void fillTlb( pager &paging, int core, const tlbEntry &entry )
+{
+   vector<tlbEntry> &tlb = paging.tlbs[core];
+   size_t index = 0;
+   size_t oldest = 0;
+
+   if( paging.stats.tlbSize == 0 )
+   {
+      return;
+   }
+
+   if( (int) tlb.size( ) < paging.stats.tlbSize )
+   {
+      tlb.push_back( entry );
+      return;
+   }
+
+   for( index = 1; index < tlb.size( ); index++ )
+   {
+      if( tlb[index].lastUse < tlb[oldest].lastUse )
+      {
+         oldest = index;
+      }
+   }
+
+   tlb[oldest] = entry;
+}
+
+/**
+ * @brief runReferences function.
+ *
+ * @details makes up to count of a process's next page references on a
+ *          core.
+ *
+ * @param in: paging, owner (process ID), core, count
+ *
+ * @param out: walks (TLB misses that walked the page table)
+ *
+ * @note Returns the references made. Fewer than count means the next one
+ *       is to a page that is not resident: that page fault is counted and
+ *       the reference is left for loadPage to make.
+ */
+int runReferences( pager &paging, int owner, int core, int count, int &walks )
+{
+   processPages &table = paging.tables[owner];
+   vector<tlbEntry> &tlb = paging.tlbs[core];
+   tlbEntry entry;
+   size_t index = 0;
+   int done = 0;
+   int page = 0;
+   int frame = 0;
+
+   walks = 0;
+
+   while( ( done < count ) && ( table.position < table.refs.size( ) ) )
+   {
+      page = table.refs[table.position];
+      frame = -1;
+      paging.tick++;
+
+      for( index = 0; index < tlb.size( ); index++ )
+      {
+         if( ( tlb[index].owner == owner ) && ( tlb[index].page == page ) )
+         {
+            tlb[index].lastUse = paging.tick;
+            frame = tlb[index].frame;
+            break;
+         }
+      }
+
+      if( frame >= 0 )
+      {
+         paging.stats.tlbHits++;
+      }
+      else
+      {
+         paging.stats.tlbMisses++;
+         frame = table.frames[page];
+
+         if( frame < 0 )
+         {
+            paging.stats.faults++;
+            return done;
+         }
+
+         walks++;
+         entry.owner = owner;
+         entry.page = page;
+         entry.frame = frame;
+         entry.lastUse = paging.tick;
+         fillTlb( paging, core, entry );
+      }
+
+      completeReference( paging, table, frame );
+      done++;
+   }
+
+   return done;
+}
+
+/**
+ * @brief faultAddress function.
+ *
+ * @details virtual address of the page a process faulted on.
+ *
+ * @param in: paging, owner (process ID)
+ *
+ * @note N/A.
+ */
+unsigned int faultAddress( pager &paging, int owner )
+{
+   processPages &table = paging.tables[owner];
+
+   return table.refs[table.position] * paging.pageSize;
+}
+
+/**
+ * @brief pickVictim function.
+ *
+ * @details picks the frame to take when none is free.
+ *
+ * @param in: paging
+ *
+ * @note OPT compares how many of its own process's references away each
+ *       page's next use is; pages not used again go first.
+ */
+static int pickVictim( pager &paging )
+{
+   int count = paging.frames.size( );
+   int index = 0;
+   int victim = 0;
+   size_t distance = 0;
+   size_t farthest = 0;
+
+   switch( paging.stats.policy )
+   {
+      case CLOCK_REPLACEMENT:
+         while( paging.frames[paging.hand].referenced )
+         {
+            paging.frames[paging.hand].referenced = false;
+            paging.hand = ( paging.hand + 1 ) % count;
+         }
+
+         victim = paging.hand;
+         paging.hand = ( paging.hand + 1 ) % count;
+         return victim;
+
+      case OPT_REPLACEMENT:
+         for( index = 0; index < count; index++ )
+         {
+            processPages &table = paging.tables[paging.frames[index].owner];
+
+            distance = table.nextRef[paging.frames[index].page];
+
+            if( distance != NEVER )
+            {
+               distance = distance - table.position;
+            }
+
+            if( ( index == 0 ) || ( distance > farthest ) )
+            {
+               farthest = distance;
+               victim = index;
+            }
+         }
+         return victim;
+
+      case LRU_REPLACEMENT:
+         for( index = 1; index < count; index++ )
+         {
+            if( paging.frames[index].lastUse < paging.frames[victim].lastUse )
+            {
+               victim = index;
+            }
+         }
+         return victim;
+
+      default:
+         for( index = 1; index < count; index++ )
+         {
+            if( paging.frames[index].loaded < paging.frames[victim].loaded )
+            {
+               victim = index;
+            }
+         }
+         return victim;
+   }
+}
+
+/**
+ * @brief flushTlbs function.
+ *
+ * @details drops translations from every core's TLB.
+ *
+ * @param in: paging, owner (process ID), page (-1 for all of its pages)
+ *
+ * @note N/A.
+ */
+static void flushTlbs( pager &paging, int owner, int page )
+{
+   size_t core = 0;
+   size_t index = 0;
+
+   for( core = 0; core < paging.tlbs.size( ); core++ )
+   {
+      vector<tlbEntry> &tlb = paging.tlbs[core];
+
+      for( index = 0; index < tlb.size( ); )
+      {
+         if( ( tlb[index].owner == owner ) && ( ( page < 0 ) || ( tlb[index].page == page ) ) )
+         {
+            tlb[index] = tlb.back( );
+            tlb.pop_back( );
+         }
+         else
+         {
+            index++;
+         }
+      }
+   }
+}
+
+/**
+ * @brief loadPage function.
+ *
+ * @details finishes a page fault: brings the page in and makes the
+ *          reference that faulted.
+ *
+ * @param in: paging, owner (process ID), waited (time since the fault)
+ *
+ * @note Takes a free frame, or evicts the policy's victim from its
+ *       owner's page table and every TLB. Making the reference here means
+ *       the page cannot be evicted again before the process uses it.
+ */
+void loadPage( pager &paging, int owner, simTime waited )
+{
+   processPages &table = paging.tables[owner];
+   int page = table.refs[table.position];
+   int frame = 0;
+
+   if( !paging.freeFrames.empty( ) )
+   {
+      frame = paging.freeFrames.back( );
+      paging.freeFrames.pop_back( );
+   }
+   else
+   {
+      frame = pickVictim( paging );
+      paging.tables[paging.frames[frame].owner].frames[paging.frames[frame].page] = -1;
+      flushTlbs( paging, paging.frames[frame].owner, paging.frames[frame].page );
+      paging.stats.evictions++;
+   }
+
+   paging.tick++;
+   paging.frames[frame].owner = owner;
+   paging.frames[frame].page = page;
+   paging.frames[frame].loaded = paging.tick;
+   table.frames[page] = frame;
+   paging.stats.faultWait = paging.stats.faultWait + waited;
+
+   completeReference( paging, table, frame );
+}
+
+/**
+ * @brief releasePages function.
+ *
+ * @details frees a finished process's frames and page table.
+ *
+ * @param in: paging, owner (process ID)
+ *
+ * @note N/A.
+ */
+void releasePages( pager &paging, int owner )
+{
+   unordered_map<int, processPages>::iterator found = paging.tables.find( owner );
+   size_t page = 0;
+   int frame = 0;
+
+   if( found == paging.tables.end( ) )
+   {
+      return;
+   }
+
+   for( page = 0; page < found->second.frames.size( ); page++ )
+   {
+      frame = found->second.frames[page];
+
+      if( frame >= 0 )
+      {
+         paging.frames[frame].owner = -1;
+         paging.frames[frame].referenced = false;
+         paging.freeFrames.push_back( frame );
+      }
+   }
+
+   flushTlbs( paging, owner, -1 );
+   paging.tables.erase( found );
+}
+
+/**
+ * @brief replacementPolicyName function.
+ *
+ * @details config code of a page replacement policy, for the summary.
+ *
+ * @param in: policy
+ *
+ * @note N/A.
+ */
+const char *replacementPolicyName( int policy )
+{
+   switch( policy )
+   {
+      case FIFO_REPLACEMENT:
+         return "FIFO";
+
+      case LRU_REPLACEMENT:
+         return "LRU";
+
+      case CLOCK_REPLACEMENT:
+         return "CLOCK";
+
+      case OPT_REPLACEMENT:
+         return "OPT";
+
+      default:
+         return "none";
+   }
+}
+
+/**
+ * @brief printPagingSummary function.
+ *
+ * @details prints the paging figures of a run.
+ *
+ * @param in: stats, processCount
+ *
+ * @note The TLB hit rate is over every lookup, faults included; the fault
+ *       rate is per reference.
+ */
+void printPagingSummary( pagingStats &stats, int processCount )
+{
+   streamsize oldPrecision = cout.precision( );
+   long long lookups = stats.tlbHits + stats.tlbMisses;
+   double hitRate = 0;
+   double faultRate = 0;
+   double meanWait = 0;
+
+   if( lookups > 0 )
+   {
+      hitRate = (double) stats.tlbHits / lookups;
+   }
+   if( stats.references > 0 )
+   {
+      faultRate = (double) stats.faults / stats.references;
+   }
+   if( processCount > 0 )
+   {
+      meanWait = toSeconds( stats.faultWait ) / processCount;
+   }
+
+   cout << fixed << setprecision(3);
+   cout << "Paging: " << replacementPolicyName( stats.policy ) << ", " << stats.frames << " frames, TLB "
+        << stats.tlbSize << " entries per core" << endl;
+   cout << "Page references: " << stats.references << ", TLB hit rate " << hitRate << endl;
+   cout << "Page faults: " << stats.faults << " (rate " << faultRate << "), evictions " << stats.evictions << endl;
+   cout << "Page fault wait total/mean per process (sec): " << toSeconds( stats.faultWait ) << " / " << meanWait << endl;
+   cout.unsetf( ios::floatfield );
+   cout.precision( oldPrecision );
+}
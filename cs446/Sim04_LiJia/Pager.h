@@ -0,0 +1,154 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file Pager.h
+ *
+ * @brief Demand paging model for the CS 446/646 operating system simulator.
+ *
+ * @details Turned on by a "Page Replacement Code" config line. Memory is
+ *          then split into frames of "Memory block size" kbytes, each
+ *          process gets a page table, and every processor core a TLB of
+ *          "TLB entries" entries. A process starts with one page and each
+ *          M(allocate) adds another; a page gets a frame the first time it
+ *          is referenced. Each cycle of an M(block) operation is one page
+ *          reference. When no frame is free the policy picks the victim
+ *          from all processes' pages:
+ *
+ *          FIFO  - the page loaded longest ago
+ *          LRU   - the page referenced longest ago
+ *          CLOCK - second chance, a hand sweeping the frames and clearing
+ *                  reference bits
+ *          OPT   - the page whose next reference is farthest away in its
+ *                  own process's reference string, as a reference point
+ *
+ *          A process's references are planned when it is admitted, from
+ *          its operations and a generator seeded by its process ID, so a
+ *          run is repeatable and OPT can see the future. The generator
+ *          mostly stays on the last page or moves to a neighbouring one,
+ *          with the occasional jump anywhere in the address space.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef PAGER_H
+#define PAGER_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "data.h"
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+enum replacementPolicy
+{
+   NO_PAGING,
+   FIFO_REPLACEMENT,
+   LRU_REPLACEMENT,
+   CLOCK_REPLACEMENT,
+   OPT_REPLACEMENT
+};
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct pageFrame
+{
+   // process ID and page held, owner -1 if free
+   int owner;
+   int page;
+
+   // reference counter values when loaded and last referenced
+   long long loaded;
+   long long lastUse;
+   bool referenced;
+};
+
+struct tlbEntry
+{
+   int owner;
+   int page;
+   int frame;
+   long long lastUse;
+};
+
+struct processPages
+{
+   // frame of each page, -1 if not resident
+   vector<int> frames;
+
+   // planned reference string, and the next reference to make
+   vector<int> refs;
+   size_t position;
+
+   // for OPT: index of the next reference to the same page, and of the
+   // next reference to each page from position on
+   vector<size_t> nextSame;
+   vector<size_t> nextRef;
+};
+
+struct pagingStats
+{
+   int policy;
+   int frames;
+   int tlbSize;
+   long long references;
+   long long tlbHits;
+   long long tlbMisses;
+   long long faults;
+   long long evictions;
+
+   // time processes spent waiting for page-ins
+   simTime faultWait;
+};
+
+struct pager
+{
+   int pageSize;
+   vector<pageFrame> frames;
+   vector<int> freeFrames;
+   int hand;
+   long long tick;
+
+   // page tables by process ID
+   unordered_map<int, processPages> tables;
+
+   // one TLB per core
+   vector< vector<tlbEntry> > tlbs;
+
+   pagingStats stats;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+int findReplacementPolicy( const string &code );
+
+void initPager( pager &paging, int policy, int systemSize, int pageSize, int tlbSize, int cores );
+
+int referenceCount( configData &fileData, const opRecord &op );
+
+void planReferences( pager &paging, configData &fileData, int owner, const vector<opRecord> &ops );
+
+unsigned int addPage( pager &paging, int owner );
+
+int runReferences( pager &paging, int owner, int core, int count, int &walks );
+
+unsigned int faultAddress( pager &paging, int owner );
+
+void loadPage( pager &paging, int owner, simTime waited );
+
+void releasePages( pager &paging, int owner );
+
+const char *replacementPolicyName( int policy );
+
+void printPagingSummary( pagingStats &stats, int processCount );
+
+#endif // PAGER_H
@@ -0,0 +1,287 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file Scheduler.cpp
+ *
+ * @brief CPU scheduler implementation for the CS 446/646 operating system
+ *        simulator.
+ *
+ * @details Every policy shares one ready heap; they differ only in the key a
+ *          process is queued under. FIFO and RR queue everything under the
+ *          same key so the heap falls back to arrival order.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "Scheduler.h"
+#include <algorithm>
+
+using namespace std;
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief laterEntry function.
+ *
+ * @details heap ordering; true if one is picked after two.
+ *
+ * @param in: one, two
+ *
+ * @note N/A.
+ */
+static bool laterEntry( const readyEntry &one, const readyEntry &two )
+{
+   if( one.key != two.key )
+   {
+      return one.key > two.key;
+   }
+
+   return one.sequence > two.sequence;
+}
+
+/**
+ * @brief readyKey function.
+ *
+ * @details the key a process is queued under for the current policy.
+ *
+ * @param in: sched, pcb
+ *
+ * @note Lower keys run first.
+ */
+static long long readyKey( scheduler &sched, PCB &pcb )
+{
+   switch( sched.policy )
+   {
+      case SJF_POLICY:
+         return pcb.totalTime;
+
+      case SRTF_POLICY:
+         return pcb.remainingTime;
+
+      case PS_POLICY:
+         return -pcb.priority;
+
+      default:
+         return 0;
+   }
+}
+
+/**
+ * @brief findPolicy function.
+ *
+ * @details maps a "CPU Scheduling Code" value to its policy.
+ *
+ * @param in: code
+ *
+ * @note Returns -1 for an unknown code.
+ */
+int findPolicy( const string &code )
+{
+   if( code == "FIFO" || code == "FCFS" )
+   {
+      return FIFO_POLICY;
+   }
+   if( code == "SJF" )
+   {
+      return SJF_POLICY;
+   }
+   if( code == "SRTF" || code == "STR" )
+   {
+      return SRTF_POLICY;
+   }
+   if( code == "RR" )
+   {
+      return RR_POLICY;
+   }
+   if( code == "PS" )
+   {
+      return PS_POLICY;
+   }
+
+   return -1;
+}
+
+/**
+ * @brief initScheduler function.
+ *
+ * @details sets the policy and quantum and empties the ready queue.
+ *
+ * @param in: sched, policy, quantum
+ *
+ * @note The quantum only matters for the preemptive policies.
+ */
+void initScheduler( scheduler &sched, int policy, simTime quantum )
+{
+   sched.policy = policy;
+   sched.quantum = quantum;
+   sched.ready.clear( );
+   sched.nextSequence = 0;
+}
+
+/**
+ * @brief addReady function.
+ *
+ * @details puts a process in the ready queue.
+ *
+ * @param in: sched, process, pcb
+ *
+ * @note The key is taken now; a waiting process's times do not change.
+ */
+void addReady( scheduler &sched, int process, PCB &pcb )
+{
+   readyEntry entry;
+
+   entry.key = readyKey( sched, pcb );
+   entry.sequence = sched.nextSequence;
+   entry.process = process;
+   sched.nextSequence++;
+
+   sched.ready.push_back( entry );
+   push_heap( sched.ready.begin( ), sched.ready.end( ), laterEntry );
+}
+
+/**
+ * @brief pickReady function.
+ *
+ * @details removes the process that should run next.
+ *
+ * @param in: sched
+ *
+ * @note Returns -1 if no process is ready.
+ */
+int pickReady( scheduler &sched )
+{
+   int process;
+
+   if( sched.ready.empty( ) )
+   {
+      return -1;
+   }
+
+   pop_heap( sched.ready.begin( ), sched.ready.end( ), laterEntry );
+   process = sched.ready.back( ).process;
+   sched.ready.pop_back( );
+
+   return process;
+}
+
+/**
+ * @brief readyEmpty function.
+ *
+ * @details true if no process is ready.
+ *
+ * @param in: sched
+ *
+ * @note N/A.
+ */
+bool readyEmpty( scheduler &sched )
+{
+   return sched.ready.empty( );
+}
+
+/**
+ * @brief slicedPolicy function.
+ *
+ * @details true if processing actions run in quantum slices.
+ *
+ * @param in: sched
+ *
+ * @note N/A.
+ */
+bool slicedPolicy( scheduler &sched )
+{
+   return ( sched.policy == RR_POLICY || sched.policy == SRTF_POLICY )
+          && sched.quantum > 0;
+}
+
+/**
+ * @brief shouldPreempt function.
+ *
+ * @details true if the running process should give up the processor at a
+ *          slice boundary.
+ *
+ * @param in: sched, running
+ *
+ * @note RR preempts whenever someone is waiting, SRTF only for a process
+ *       with less time left.
+ */
+bool shouldPreempt( scheduler &sched, PCB &running )
+{
+   if( sched.ready.empty( ) )
+   {
+      return false;
+   }
+
+   switch( sched.policy )
+   {
+      case RR_POLICY:
+         return true;
+
+      case SRTF_POLICY:
+         return sched.ready.front( ).key < running.remainingTime;
+
+      default:
+         return false;
+   }
+}
+
+/**
+ * @brief interruptPreempts function.
+ *
+ * @details true if a process made ready by an I/O interrupt should take the
+ *          processor from the running process straight away.
+ *
+ * @param in: sched, running, ranFor, woken
+ *
+ * @note ranFor is how long the running process has been in its current
+ *       slice. RR waits for the quantum to expire instead.
+ */
+bool interruptPreempts( scheduler &sched, PCB &running, simTime ranFor, PCB &woken )
+{
+   switch( sched.policy )
+   {
+      case SRTF_POLICY:
+         return woken.remainingTime < running.remainingTime - ranFor;
+
+      case PS_POLICY:
+         return woken.priority > running.priority;
+
+      default:
+         return false;
+   }
+}
+
+/**
+ * @brief policyName function.
+ *
+ * @details config code of a policy, for the summary.
+ *
+ * @param in: policy
+ *
+ * @note N/A.
+ */
+const char *policyName( int policy )
+{
+   switch( policy )
+   {
+      case SJF_POLICY:
+         return "SJF";
+
+      case SRTF_POLICY:
+         return "SRTF";
+
+      case RR_POLICY:
+         return "RR";
+
+      case PS_POLICY:
+         return "PS";
+
+      default:
+         return "FIFO";
+   }
+}
@@ -0,0 +1,94 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file Scheduler.h
+ *
+ * @brief CPU scheduler for the CS 446/646 operating system simulator.
+ *
+ * @details Holds the ready processes and decides which one runs next. The
+ *          policy comes from the "CPU Scheduling Code" config line:
+ *
+ *          FIFO - first come, first served
+ *          SJF  - shortest job first, by total process time
+ *          SRTF - shortest remaining time first, preemptive (STR is
+ *                 accepted too)
+ *          RR   - round robin with the configured quantum
+ *          PS   - priority scheduling, the process with the most I/O
+ *                 operations first
+ *
+ *          The preemptive policies run processing actions in quantum
+ *          slices and are asked at each slice boundary whether the running
+ *          process should give up the processor. SRTF and PS are also asked
+ *          when an I/O interrupt makes a process ready mid-slice.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include "data.h"
+#include "SimClock.h"
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+enum schedPolicy
+{
+   FIFO_POLICY,
+   SJF_POLICY,
+   SRTF_POLICY,
+   RR_POLICY,
+   PS_POLICY
+};
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct readyEntry
+{
+   long long key;
+   long long sequence;
+   int process;
+};
+
+struct scheduler
+{
+   int policy;
+   simTime quantum;
+
+   // min-heap on key, then arrival order in the ready queue
+   vector<readyEntry> ready;
+   long long nextSequence;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+int findPolicy( const string &code );
+
+void initScheduler( scheduler &sched, int policy, simTime quantum );
+
+void addReady( scheduler &sched, int process, PCB &pcb );
+
+int pickReady( scheduler &sched );
+
+bool readyEmpty( scheduler &sched );
+
+bool slicedPolicy( scheduler &sched );
+
+bool shouldPreempt( scheduler &sched, PCB &running );
+
+bool interruptPreempts( scheduler &sched, PCB &running, simTime ranFor, PCB &woken );
+
+const char *policyName( int policy );
+
+#endif // SCHEDULER_H
@@ -0,0 +1,411 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file SimClock.cpp
+ *
+ * @brief Simulation clock implementation for the CS 446/646 operating system
+ *        simulator.
+ *
+ * @details Implements the real-time and virtual-time backends of the
+ *          simulation clock.
+ *
+ * @author Jia Li
+ *
+ * @version 1.03
+ *          Jia Li (16 October 2026)
+ *          Requested versus actual operation times, with drift
+ *
+ * @version 1.02
+ *          Jia Li (16 October 2026)
+ *          Absolute deadlines for the event-driven engine
+ *
+ * @version 1.01
+ *          Jia Li (16 October 2026)
+ *          Sleeping deadline timer with overshoot statistics
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "SimClock.h"
+#include <iostream>
+#include <iomanip>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief readMonotonic function.
+ *
+ * @details returns CLOCK_MONOTONIC in nanoseconds.
+ *
+ * @param in: None
+ *
+ * @note N/A.
+ */
+long long readMonotonic( )
+{
+   struct timespec current;
+
+   clock_gettime( CLOCK_MONOTONIC, &current );
+
+   return current.tv_sec * NSEC_PER_SEC + current.tv_nsec;
+}
+
+/**
+ * @brief initClock function.
+ *
+ * @details prepares the clock and clears the timer statistics.
+ *
+ * @param in: clock, virtualTime, spinTime
+ *
+ * @note spinTime is how long before each deadline the real-time backend
+ *       stops sleeping and busy waits. Zero means sleep only.
+ */
+void initClock( simClock &clock, bool virtualTime, simTime spinTime )
+{
+   clock.virtualTime = virtualTime;
+   clock.spinTime = spinTime;
+   clock.waitCount = 0;
+   clock.totalOvershoot = 0;
+   clock.maxOvershoot = 0;
+   clock.timedOps = 0;
+   clock.requestedTime = 0;
+   clock.actualTime = 0;
+   clock.maxOpOvershoot = 0;
+   memset( clock.opOvershoot, 0, sizeof( clock.opOvershoot ) );
+   pthread_mutex_init( &clock.statLock, NULL );
+   startClock( clock );
+}
+
+/**
+ * @brief startClock function.
+ *
+ * @details sets time zero of the simulation.
+ *
+ * @param in: clock
+ *
+ * @note In virtual-time mode the wall clock is never read again.
+ */
+void startClock( simClock &clock )
+{
+   clock.now = 0;
+   clock_gettime( CLOCK_MONOTONIC, &clock.start );
+}
+
+/**
+ * @brief readClock function.
+ *
+ * @details returns the time in microseconds since the clock was started.
+ *
+ * @param in: clock
+ *
+ * @note Virtual-time mode returns the simulated counter.
+ */
+simTime readClock( simClock &clock )
+{
+   long long startTime;
+
+   if( clock.virtualTime )
+   {
+      return clock.now;
+   }
+
+   startTime = clock.start.tv_sec * NSEC_PER_SEC + clock.start.tv_nsec;
+
+   return ( readMonotonic( ) - startTime ) / NSEC_PER_USEC;
+}
+
+/**
+ * @brief waitClock function.
+ *
+ * @details waits for the given duration, measured from the current reading
+ *          of the clock.
+ *
+ * @param in: clock, duration
+ *
+ * @note The real-time backend sleeps with clock_nanosleep until an absolute
+ *       deadline, so it uses no CPU and an interrupted sleep resumes
+ *       against the same deadline. If a spin time is set, the sleep ends
+ *       that much early and the remainder is busy waited for accuracy.
+ *       The overshoot past the deadline is recorded for the run summary.
+ *       Virtual-time mode advances the counter and returns immediately.
+ */
+void waitClock( simClock &clock, simTime duration )
+{
+   long long deadline;
+   long long sleepUntil;
+   long long overshoot;
+   struct timespec wakeTime;
+
+   if( clock.virtualTime )
+   {
+      clock.now = clock.now + duration;
+      return;
+   }
+
+   deadline = readMonotonic( ) + duration * NSEC_PER_USEC;
+   sleepUntil = deadline - clock.spinTime * NSEC_PER_USEC;
+
+   wakeTime.tv_sec = sleepUntil / NSEC_PER_SEC;
+   wakeTime.tv_nsec = sleepUntil % NSEC_PER_SEC;
+
+   while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, NULL ) == EINTR )
+   {
+      // resume the sleep against the same deadline
+   }
+
+   while( readMonotonic( ) < deadline )
+   {
+      // final spin for accuracy
+   }
+
+   overshoot = readMonotonic( ) - deadline;
+
+   recordOvershoot( clock, overshoot );
+}
+
+/**
+ * @brief advanceClock function.
+ *
+ * @details moves the virtual clock forward to the given time.
+ *
+ * @param in: clock, time
+ *
+ * @note Used by the event-driven engine, which knows the time of its next
+ *       event. The clock never moves backwards, and real-time mode is left
+ *       alone because the wall clock is already there.
+ */
+void advanceClock( simClock &clock, simTime time )
+{
+   if( clock.virtualTime && ( time > clock.now ) )
+   {
+      clock.now = time;
+   }
+}
+
+/**
+ * @brief clockDeadline function.
+ *
+ * @details converts a clock reading to an absolute CLOCK_MONOTONIC time.
+ *
+ * @param in: clock, time
+ *
+ * @note Used for timed waits that must end at a simulation time.
+ */
+struct timespec clockDeadline( simClock &clock, simTime time )
+{
+   struct timespec deadline;
+   long long absolute = clock.start.tv_sec * NSEC_PER_SEC + clock.start.tv_nsec +
+                        time * NSEC_PER_USEC;
+
+   deadline.tv_sec = absolute / NSEC_PER_SEC;
+   deadline.tv_nsec = absolute % NSEC_PER_SEC;
+
+   return deadline;
+}
+
+/**
+ * @brief recordOvershoot function.
+ *
+ * @details adds one finished wait to the timer statistics.
+ *
+ * @param in: clock, overshoot
+ *
+ * @note overshoot is in nanoseconds. Safe to call from any thread.
+ */
+void recordOvershoot( simClock &clock, long long overshoot )
+{
+   pthread_mutex_lock( &clock.statLock );
+   clock.waitCount++;
+   clock.totalOvershoot = clock.totalOvershoot + overshoot;
+   if( overshoot > clock.maxOvershoot )
+   {
+      clock.maxOvershoot = overshoot;
+   }
+   pthread_mutex_unlock( &clock.statLock );
+}
+
+/**
+ * @brief timingBucket function.
+ *
+ * @details histogram bucket of an overshoot.
+ *
+ * @param in: overshoot (usec)
+ *
+ * @note Buckets are exact below TIMING_SUB_BUCKETS and within 1/8 of the
+ *       value above.
+ */
+static int timingBucket( simTime overshoot )
+{
+   int exponent = 3;
+
+   if( overshoot < TIMING_SUB_BUCKETS )
+   {
+      return (int) overshoot;
+   }
+
+   while( ( overshoot >> ( exponent + 1 ) ) > 0 )
+   {
+      exponent++;
+   }
+
+   return ( exponent - 2 ) * TIMING_SUB_BUCKETS +
+          (int) ( ( overshoot >> ( exponent - 3 ) ) & ( TIMING_SUB_BUCKETS - 1 ) );
+}
+
+/**
+ * @brief bucketLimit function.
+ *
+ * @details largest overshoot that falls in a histogram bucket.
+ *
+ * @param in: bucket
+ *
+ * @note N/A.
+ */
+static simTime bucketLimit( int bucket )
+{
+   int exponent = bucket / TIMING_SUB_BUCKETS + 2;
+   simTime low = 0;
+
+   if( bucket < TIMING_SUB_BUCKETS )
+   {
+      return bucket;
+   }
+
+   low = (simTime) ( TIMING_SUB_BUCKETS + bucket % TIMING_SUB_BUCKETS ) << ( exponent - 3 );
+
+   return low + ( (simTime) 1 << ( exponent - 3 ) ) - 1;
+}
+
+/**
+ * @brief recordOpTiming function.
+ *
+ * @details adds one finished operation to the timing statistics.
+ *
+ * @param in: clock, requested, actual
+ *
+ * @note Both times are in microseconds. Only the engine thread records, so
+ *       no lock is taken. An operation that finished early counts as no
+ *       overshoot in the histogram but still counts toward the drift.
+ */
+void recordOpTiming( simClock &clock, simTime requested, simTime actual )
+{
+   simTime overshoot = ( actual > requested ) ? actual - requested : 0;
+
+   clock.timedOps++;
+   clock.requestedTime = clock.requestedTime + requested;
+   clock.actualTime = clock.actualTime + actual;
+   clock.opOvershoot[timingBucket( overshoot )]++;
+
+   if( overshoot > clock.maxOpOvershoot )
+   {
+      clock.maxOpOvershoot = overshoot;
+   }
+}
+
+/**
+ * @brief overshootPercentile function.
+ *
+ * @details overshoot that a fraction of the timed operations stay within.
+ *
+ * @param in: clock, fraction
+ *
+ * @note Gives the top of the bucket, capped at the largest overshoot seen.
+ */
+static simTime overshootPercentile( simClock &clock, double fraction )
+{
+   long long wanted = (long long) ( fraction * clock.timedOps + 0.999999 );
+   long long seen = 0;
+   int bucket = 0;
+
+   for( bucket = 0; bucket < TIMING_BUCKETS; bucket++ )
+   {
+      seen = seen + clock.opOvershoot[bucket];
+
+      if( ( seen >= wanted ) && ( seen > 0 ) )
+      {
+         return min( bucketLimit( bucket ), clock.maxOpOvershoot );
+      }
+   }
+
+   return clock.maxOpOvershoot;
+}
+
+/**
+ * @brief printClockSummary function.
+ *
+ * @details prints the timer precision statistics to the monitor.
+ *
+ * @param in: clock
+ *
+ * @note Overshoot is how far past its deadline each real wait returned.
+ *       Operation overshoot is how much longer each processing, memory,
+ *       context switch and I/O operation took than its cycles asked for,
+ *       measured from when it started, or for I/O could have started, to
+ *       when the engine handled its end. Drift is the sum of those
+ *       differences, the time the run lost to the clock.
+ */
+void printClockSummary( simClock &clock )
+{
+   double meanOvershoot = 0.0;
+   streamsize oldPrecision = cout.precision( );
+
+   if( clock.waitCount > 0 )
+   {
+      meanOvershoot = (double) clock.totalOvershoot / clock.waitCount / NSEC_PER_USEC;
+   }
+
+   cout << "Timer: " << ( clock.virtualTime ? "virtual" : "deadline sleep" );
+   cout << ", spin " << clock.spinTime << " usec" << endl;
+
+   if( !clock.virtualTime )
+   {
+      cout << "Timer waits: " << clock.waitCount << endl;
+      cout << fixed << setprecision(3);
+      cout << "Timer overshoot mean (usec): " << meanOvershoot << endl;
+      cout << "Timer overshoot max (usec): " << (double) clock.maxOvershoot / NSEC_PER_USEC << endl;
+      cout << "Timed operations: " << clock.timedOps << endl;
+      cout << "Operation overshoot p50/p99/max (usec): " << overshootPercentile( clock, 0.5 ) << " / "
+           << overshootPercentile( clock, 0.99 ) << " / " << clock.maxOpOvershoot << endl;
+      cout << "Operation drift (sec): " << toSeconds( clock.actualTime - clock.requestedTime ) << ", "
+           << ( ( clock.requestedTime > 0 ) ? (double) ( clock.actualTime - clock.requestedTime ) / clock.requestedTime : 0.0 )
+           << " of the requested time" << endl;
+      cout.unsetf( ios::floatfield );
+      cout.precision( oldPrecision );
+   }
+}
+
+/**
+ * @brief destroyClock function.
+ *
+ * @details releases the statistics lock.
+ *
+ * @param in: clock
+ *
+ * @note N/A.
+ */
+void destroyClock( simClock &clock )
+{
+   pthread_mutex_destroy( &clock.statLock );
+}
+
+/**
+ * @brief toSeconds function.
+ *
+ * @details converts a clock reading to seconds for the log.
+ *
+ * @param in: time
+ *
+ * @note N/A.
+ */
+double toSeconds( simTime time )
+{
+   return time / USEC_PER_SEC;
+}
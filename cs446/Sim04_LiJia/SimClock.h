@@ -0,0 +1,106 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file SimClock.h
+ *
+ * @brief Simulation clock for the CS 446/646 operating system simulator.
+ *
+ * @details Provides one time source for the simulator. In real-time mode the
+ *          clock reads CLOCK_MONOTONIC and waits by sleeping until an
+ *          absolute deadline, optionally spinning for the last few
+ *          microseconds. In virtual-time mode the clock is a counter that
+ *          jumps forward by each duration, so no real waiting is performed.
+ *
+ * @author Jia Li
+ *
+ * @version 1.03
+ *          Jia Li (16 October 2026)
+ *          Requested versus actual operation times, with drift
+ *
+ * @version 1.02
+ *          Jia Li (16 October 2026)
+ *          Absolute deadlines for the event-driven engine
+ *
+ * @version 1.01
+ *          Jia Li (16 October 2026)
+ *          Sleeping deadline timer with overshoot statistics
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <ctime>
+#include <pthread.h>
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+// simulated time is kept in whole microseconds
+typedef long long simTime;
+
+const simTime USEC_PER_MSEC = 1000;
+const double USEC_PER_SEC = 1000000.0;
+const long long NSEC_PER_USEC = 1000;
+const long long NSEC_PER_SEC = 1000000000;
+
+// operation timing histogram: values under TIMING_SUB_BUCKETS microseconds
+// get a bucket each, larger ones TIMING_SUB_BUCKETS per power of two
+const int TIMING_SUB_BUCKETS = 8;
+const int TIMING_BUCKETS = 64 * TIMING_SUB_BUCKETS;
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct simClock
+{
+   bool virtualTime;
+   struct timespec start;
+   simTime now;
+   simTime spinTime;
+
+   // timer precision, guarded by statLock since device threads wait too
+   pthread_mutex_t statLock;
+   long long waitCount;
+   long long totalOvershoot;
+   long long maxOvershoot;
+
+   // requested against actual operation times, recorded by the engine
+   long long timedOps;
+   simTime requestedTime;
+   simTime actualTime;
+   simTime maxOpOvershoot;
+   long long opOvershoot[TIMING_BUCKETS];
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+void initClock( simClock &clock, bool virtualTime, simTime spinTime );
+
+void startClock( simClock &clock );
+
+simTime readClock( simClock &clock );
+
+void waitClock( simClock &clock, simTime duration );
+
+void advanceClock( simClock &clock, simTime time );
+
+struct timespec clockDeadline( simClock &clock, simTime time );
+
+long long readMonotonic( );
+
+void recordOvershoot( simClock &clock, long long overshoot );
+
+void recordOpTiming( simClock &clock, simTime requested, simTime actual );
+
+void printClockSummary( simClock &clock );
+
+void destroyClock( simClock &clock );
+
+double toSeconds( simTime time );
+
+#endif // SIM_CLOCK_H
@@ -0,0 +1,1441 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file Simulator.cpp
+ *
+ * @brief Simulation engine implementation for the CS 446/646 operating
+ *        system simulator.
+ *
+ * @details An event-driven engine. Processing and memory operations end
+ *          with an event on the pending-event set; I/O operations end when
+ *          their device unit completes them. In virtual time the engine
+ *          jumps from one event to the next. In real time it sleeps until
+ *          the next event's deadline and wakes early for device completions.
+ *
+ *          With paging on, an M(block) operation runs its page references
+ *          until one faults. The process then waits for the page to be read
+ *          from a hard drive unit like any I/O operation and carries on
+ *          with the rest of the references once it is loaded.
+ *
+ *          A device completion is handled as an interrupt: the process
+ *          becomes ready and, if the scheduler says so, takes the processor
+ *          from the process in the middle of a processing slice. The
+ *          preempted slice's pending event is cancelled by forgetting its
+ *          sequence number and is dropped when it comes out of the queue.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "Simulator.h"
+#include "EventQueue.h"
+#include "Scheduler.h"
+#include "MetaStream.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+enum engineEventType
+{
+   CPU_DONE,
+   IO_DONE,
+   SWITCH_DONE
+};
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct cpuCore
+{
+   int running;
+   scheduler sched;
+
+   simTime opStart;
+   simTime sliceTime;
+
+   // sequence of the pending CPU_DONE or SWITCH_DONE event, -1 if none
+   long long cpuEvent;
+   bool inSlice;
+   int lastRan;
+
+   // position in the idle set, -1 if not in it
+   int idleSlot;
+   bool awake;
+
+   simTime busy;
+   long long switchCount;
+   long long steals;
+};
+
+struct simState
+{
+   metaFeed *feed;
+   configData *fileData;
+   simClock *clock;
+   logSink *sink;
+   devicePool *pool;
+
+   // process table; slots of finished processes are reused
+   vector<PCB> processes;
+   vector<int> freeSlots;
+   int admitted;
+   bool feedDone;
+   bool pendingStart;
+
+   vector<cpuCore> cores;
+   vector<int> idleCores;
+   vector<int> wakeList;
+   eventQueue events;
+   int remaining;
+
+   int processorDevice;
+   memoryManager memory;
+   pager paging;
+   int pagingDevice;
+   simTime switchTime;
+
+   // figures of finished processes
+   simTime totalTurnaround;
+   simTime maxTurnaround;
+   simTime totalWaiting;
+   simTime maxWaiting;
+   simTime totalResponse;
+   simTime maxResponse;
+   simTime totalDrift;
+   simTime maxDrift;
+};
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief findComponent function.
+ *
+ * @details finds the device registry entry of a component.
+ *
+ * @param in: fileData, name
+ *
+ * @note The first letter is looked up in lower case so that the meta-data
+ *       descriptions match the capitalized config names. Returns -1 if
+ *       there is no match. Called by the meta-data parser, so operations
+ *       reach the engine with their device already resolved.
+ */
+int findComponent( configData &fileData, const char name[] )
+{
+   string key = name;
+   unordered_map<string, int>::iterator found;
+
+   if( key.empty( ) )
+   {
+      return -1;
+   }
+
+   key[0] = tolower( key[0] );
+   found = fileData.deviceIndex.find( key );
+
+   return ( found == fileData.deviceIndex.end( ) ) ? -1 : found->second;
+}
+
+/**
+ * @brief opDuration function.
+ *
+ * @details time an operation takes on a component.
+ *
+ * @param in: sim, device, cycles
+ *
+ * @note N/A.
+ */
+static simTime opDuration( simState &sim, int device, int cycles )
+{
+   return (simTime) cycles * sim.fileData->cycleData[device].time * USEC_PER_MSEC;
+}
+
+/**
+ * @brief logNow function.
+ *
+ * @details reports an event at the current simulation time.
+ *
+ * @param in: sim, type, process, device, instance, address
+ *
+ * @note process is an index into the process table, or -1 for the OS.
+ */
+static void logNow( simState &sim, int type, int process, int device, int instance, unsigned int address )
+{
+   logEvent event;
+
+   event.time = readClock( *sim.clock );
+   event.type = type;
+   event.processID = ( process >= 0 ) ? sim.processes[process].processID : 0;
+   event.device = device;
+   event.instance = instance;
+   event.address = address;
+
+   writeLog( *sim.sink, event );
+}
+
+/**
+ * @brief recordTiming function.
+ *
+ * @details records how long an operation of a process took against how
+ *          long it asked for.
+ *
+ * @param in: sim, process, requested, start
+ *
+ * @note The operation ends now. Real time only; in virtual time every
+ *       operation takes exactly its time.
+ */
+static void recordTiming( simState &sim, int process, simTime requested, simTime start )
+{
+   simTime actual = 0;
+
+   if( sim.clock->virtualTime )
+   {
+      return;
+   }
+
+   actual = readClock( *sim.clock ) - start;
+   recordOpTiming( *sim.clock, requested, actual );
+   sim.processes[process].drift = sim.processes[process].drift + ( actual - requested );
+}
+
+/**
+ * @brief wakeCore function.
+ *
+ * @details marks an idle core for the next dispatch pass.
+ *
+ * @param in: sim, core
+ *
+ * @note N/A.
+ */
+static void wakeCore( simState &sim, int core )
+{
+   if( !sim.cores[core].awake )
+   {
+      sim.cores[core].awake = true;
+      sim.wakeList.push_back( core );
+   }
+}
+
+/**
+ * @brief setIdle function.
+ *
+ * @details adds a core to, or takes it out of, the set of idle cores with
+ *          nothing queued.
+ *
+ * @param in: sim, core, idle
+ *
+ * @note Swap-remove keeps both directions constant time.
+ */
+static void setIdle( simState &sim, int core, bool idle )
+{
+   int slot = sim.cores[core].idleSlot;
+
+   if( idle && ( slot < 0 ) )
+   {
+      sim.cores[core].idleSlot = sim.idleCores.size( );
+      sim.idleCores.push_back( core );
+   }
+   else if( !idle && ( slot >= 0 ) )
+   {
+      sim.idleCores[slot] = sim.idleCores.back( );
+      sim.cores[sim.idleCores[slot]].idleSlot = slot;
+      sim.idleCores.pop_back( );
+      sim.cores[core].idleSlot = -1;
+   }
+}
+
+/**
+ * @brief releaseCore function.
+ *
+ * @details frees the core the process was running on.
+ *
+ * @param in: sim, process
+ *
+ * @note N/A.
+ */
+static void releaseCore( simState &sim, int process )
+{
+   int core = sim.processes[process].core;
+
+   sim.cores[core].running = -1;
+   sim.cores[core].inSlice = false;
+   wakeCore( sim, core );
+}
+
+/**
+ * @brief pushCpuEvent function.
+ *
+ * @details schedules the event that ends a core's current work.
+ *
+ * @param in: sim, type, process, time
+ *
+ * @note Only one such event is live per core.
+ */
+static void pushCpuEvent( simState &sim, int type, int process, simTime time )
+{
+   simEvent event;
+
+   event.time = time;
+   event.type = type;
+   event.process = process;
+   event.unit = -1;
+   pushEvent( sim.events, event );
+   sim.cores[sim.processes[process].core].cpuEvent = event.sequence;
+}
+
+/**
+ * @brief startCpuOp function.
+ *
+ * @details schedules the end of an operation that holds the processor.
+ *
+ * @param in: sim, process, duration
+ *
+ * @note N/A.
+ */
+static void startCpuOp( simState &sim, int process, simTime duration )
+{
+   cpuCore &core = sim.cores[sim.processes[process].core];
+
+   core.opStart = readClock( *sim.clock );
+   core.sliceTime = duration;
+   core.inSlice = false;
+   pushCpuEvent( sim, CPU_DONE, process, core.opStart + duration );
+}
+
+/**
+ * @brief startSlice function.
+ *
+ * @details runs the next piece of the running process's processing action.
+ *
+ * @param in: sim, process
+ *
+ * @note The preemptive policies run at most one quantum at a time.
+ */
+static void startSlice( simState &sim, int process )
+{
+   PCB &pcb = sim.processes[process];
+   simTime slice = pcb.opRemaining;
+
+   if( slicedPolicy( sim.cores[pcb.core].sched ) && ( slice > sim.cores[pcb.core].sched.quantum ) )
+   {
+      slice = sim.cores[pcb.core].sched.quantum;
+   }
+
+   startCpuOp( sim, process, slice );
+   sim.cores[pcb.core].inSlice = true;
+}
+
+/**
+ * @brief makeReady function.
+ *
+ * @details hands a process to the run queue of a core.
+ *
+ * @param in: sim, process
+ *
+ * @note A process goes back to the core it last ran on unless that core is
+ *       busy and another one has nothing to do. New processes are spread
+ *       round robin. Returns the core.
+ */
+static int makeReady( simState &sim, int process )
+{
+   PCB &pcb = sim.processes[process];
+   int core = pcb.core;
+
+   if( ( ( core < 0 ) || ( sim.cores[core].idleSlot < 0 ) ) && !sim.idleCores.empty( ) )
+   {
+      core = sim.idleCores.back( );
+   }
+   else if( core < 0 )
+   {
+      core = process % sim.cores.size( );
+   }
+
+   pcb.processState = READY;
+   pcb.readySince = readClock( *sim.clock );
+   addReady( sim.cores[core].sched, process, pcb );
+   setIdle( sim, core, false );
+
+   if( sim.cores[core].running < 0 )
+   {
+      wakeCore( sim, core );
+   }
+
+   return core;
+}
+
+/**
+ * @brief admitProcesses function.
+ *
+ * @details takes applications from the meta-data feed and makes them
+ *          ready, up to the feed's resident limit.
+ *
+ * @param in: sim
+ *
+ * @note An application runs from A(start) to A(end); without A(end) it
+ *       ends at the next A(start) or the end of the meta-data. Its planned
+ *       time is totalled and its I/O operations counted, which is its
+ *       priority. A stream feed may block here until the parser catches
+ *       up, which does not move the virtual clock. Each application's
+ *       operations are held whole until it ends.
+ */
+static void admitProcesses( simState &sim )
+{
+   int limit = sim.feed->residentLimit;
+   int process = 0;
+   int index = 0;
+   opRecord op;
+   PCB fresh = PCB( );
+
+   while( !sim.feedDone && ( ( limit <= 0 ) || ( sim.remaining < limit ) ) )
+   {
+      while( !sim.pendingStart )
+      {
+         if( !nextMetaOp( *sim.feed, op ) )
+         {
+            sim.feedDone = true;
+            return;
+         }
+
+         sim.pendingStart = ( op.code == OP_APP_START );
+      }
+
+      sim.pendingStart = false;
+
+      if( sim.freeSlots.empty( ) )
+      {
+         process = sim.processes.size( );
+         sim.processes.push_back( fresh );
+      }
+      else
+      {
+         process = sim.freeSlots.back( );
+         sim.freeSlots.pop_back( );
+      }
+
+      PCB &pcb = sim.processes[process];
+
+      pcb.ops.clear( );
+
+      while( true )
+      {
+         if( !nextMetaOp( *sim.feed, op ) )
+         {
+            sim.feedDone = true;
+            break;
+         }
+         if( op.code == OP_APP_END )
+         {
+            break;
+         }
+         if( op.code == OP_APP_START )
+         {
+            sim.pendingStart = true;
+            break;
+         }
+
+         pcb.ops.push_back( op );
+      }
+
+      sim.admitted++;
+      pcb.processState = START;
+      pcb.processID = sim.admitted;
+      pcb.nextOp = 0;
+      pcb.started = false;
+      pcb.arrival = readClock( *sim.clock );
+      pcb.finish = 0;
+      pcb.totalTime = 0;
+      pcb.opRemaining = 0;
+      pcb.priority = 0;
+      pcb.readySince = 0;
+      pcb.waitingTime = 0;
+      pcb.firstRun = 0;
+      pcb.core = -1;
+      pcb.pageRefs = -1;
+      pcb.pageFault = false;
+      pcb.faultStart = 0;
+      pcb.drift = 0;
+
+      for( index = 0; index < (int) pcb.ops.size( ); index++ )
+      {
+         pcb.totalTime = pcb.totalTime + pcb.ops[index].duration;
+
+         if( ( pcb.ops[index].code == OP_INPUT ) || ( pcb.ops[index].code == OP_OUTPUT ) )
+         {
+            pcb.priority++;
+         }
+      }
+
+      pcb.remainingTime = pcb.totalTime;
+      sim.remaining++;
+
+      if( sim.paging.stats.policy != NO_PAGING )
+      {
+         planReferences( sim.paging, *sim.fileData, pcb.processID, pcb.ops );
+      }
+
+      logNow( sim, PROCESS_PREPARE, process, -1, -1, 0 );
+      makeReady( sim, process );
+   }
+}
+
+/**
+ * @brief retireProcess function.
+ *
+ * @details records a finished process's figures, frees its memory or its
+ *          pages, and its slot.
+ *
+ * @param in: sim, process
+ *
+ * @note Turnaround and response are measured from the process's arrival.
+ */
+static void retireProcess( simState &sim, int process )
+{
+   PCB &pcb = sim.processes[process];
+   simTime turnaround = pcb.finish - pcb.arrival;
+   simTime response = pcb.firstRun - pcb.arrival;
+
+   sim.totalTurnaround = sim.totalTurnaround + turnaround;
+   sim.maxTurnaround = max( sim.maxTurnaround, turnaround );
+   sim.totalWaiting = sim.totalWaiting + pcb.waitingTime;
+   sim.maxWaiting = max( sim.maxWaiting, pcb.waitingTime );
+   sim.totalResponse = sim.totalResponse + response;
+   sim.maxResponse = max( sim.maxResponse, response );
+   sim.totalDrift = sim.totalDrift + pcb.drift;
+   sim.maxDrift = max( sim.maxDrift, pcb.drift );
+
+   if( sim.paging.stats.policy != NO_PAGING )
+   {
+      releasePages( sim.paging, pcb.processID );
+   }
+   else
+   {
+      releaseBlocks( sim.memory, pcb.processID );
+   }
+   vector<opRecord>( ).swap( pcb.ops );
+   sim.freeSlots.push_back( process );
+   sim.remaining--;
+}
+
+/**
+ * @brief coreInstance function.
+ *
+ * @details core number to log with a processing action.
+ *
+ * @param in: sim, process
+ *
+ * @note -1 on a single-core processor keeps the log lines unchanged.
+ */
+static int coreInstance( simState &sim, int process )
+{
+   return ( sim.cores.size( ) > 1 ) ? sim.processes[process].core : -1;
+}
+
+/**
+ * @brief waitOnDevice function.
+ *
+ * @details hands a job to a device unit and takes the process off its core
+ *          until the unit completes it.
+ *
+ * @param in: sim, process, unit, duration
+ *
+ * @note In virtual time the completion is also put on the pending-event
+ *       set; in real time the unit's worker reports it.
+ */
+static void waitOnDevice( simState &sim, int process, int unit, simTime duration )
+{
+   ioJob job;
+   simEvent event;
+
+   job.unit = unit;
+   job.process = process;
+   job.duration = duration;
+   submitIO( *sim.pool, job );
+
+   sim.processes[process].processState = WAITING;
+   releaseCore( sim, process );
+
+   if( sim.clock->virtualTime )
+   {
+      event.time = job.finished;
+      event.type = IO_DONE;
+      event.process = process;
+      event.unit = unit;
+      pushEvent( sim.events, event );
+   }
+}
+
+/**
+ * @brief startReferences function.
+ *
+ * @details runs the page references left in the running process's
+ *          M(block) operation, up to the first page fault.
+ *
+ * @param in: sim, process
+ *
+ * @note Each reference takes one memory cycle and each TLB miss another for
+ *       the page table walk. A fault is handled when this part ends.
+ */
+static void startReferences( simState &sim, int process )
+{
+   PCB &pcb = sim.processes[process];
+   opRecord &op = pcb.ops[pcb.nextOp];
+   int walks = 0;
+   int done = runReferences( sim.paging, pcb.processID, pcb.core, pcb.pageRefs, walks );
+
+   pcb.pageRefs = pcb.pageRefs - done;
+   pcb.pageFault = ( pcb.pageRefs > 0 );
+   startCpuOp( sim, process, opDuration( sim, op.device, done + walks ) );
+}
+
+/**
+ * @brief continueProcess function.
+ *
+ * @details runs the running process from its next operation until it
+ *          starts a timed operation, waits for I/O or ends.
+ *
+ * @param in: sim, process
+ *
+ * @note Operations the config has no component for are skipped, as
+ *       before. An I/O operation frees the core. An M(block) operation
+ *       that was interrupted by a page fault carries on where it stopped,
+ *       without logging its start again.
+ */
+static void continueProcess( simState &sim, int process )
+{
+   PCB &pcb = sim.processes[process];
+   int unit = 0;
+
+   while( pcb.nextOp < (int) pcb.ops.size( ) )
+   {
+      opRecord &op = pcb.ops[pcb.nextOp];
+
+      switch( op.code )
+      {
+         case OP_RUN:
+            if( pcb.opRemaining == 0 )
+            {
+               pcb.opRemaining = op.duration;
+            }
+
+            logNow( sim, CPU_START, process, -1, coreInstance( sim, process ), 0 );
+            startSlice( sim, process );
+            return;
+
+         case OP_ALLOCATE:
+            logNow( sim, MEMORY_ALLOCATE, process, -1, -1, 0 );
+            startCpuOp( sim, process, op.duration );
+            return;
+
+         case OP_BLOCK:
+            if( sim.paging.stats.policy == NO_PAGING )
+            {
+               logNow( sim, BLOCK_START, process, -1, -1, 0 );
+               startCpuOp( sim, process, op.duration );
+               return;
+            }
+
+            if( pcb.pageRefs < 0 )
+            {
+               logNow( sim, BLOCK_START, process, -1, -1, 0 );
+               pcb.pageRefs = referenceCount( *sim.fileData, op );
+            }
+
+            startReferences( sim, process );
+            return;
+
+         case OP_INPUT:
+         case OP_OUTPUT:
+            unit = pickDeviceUnit( *sim.pool, op.device );
+
+            if( unit < 0 )
+            {
+               break;
+            }
+
+            logNow( sim, ( op.code == OP_INPUT ) ? INPUT_START : OUTPUT_START, process, op.device, -1, 0 );
+            waitOnDevice( sim, process, unit, op.duration );
+            return;
+
+         default:
+            break;
+      }
+
+      pcb.nextOp++;
+   }
+
+   logNow( sim, PROCESS_REMOVE, process, -1, -1, 0 );
+   pcb.processState = EXIT;
+   pcb.finish = readClock( *sim.clock );
+   releaseCore( sim, process );
+   retireProcess( sim, process );
+}
+
+/**
+ * @brief stealWork function.
+ *
+ * @details takes a ready process from the core with the longest run queue.
+ *
+ * @param in: sim, core
+ *
+ * @note Returns -1 if every run queue is empty.
+ */
+static int stealWork( simState &sim, int core )
+{
+   int index = 0;
+   int victim = -1;
+   size_t longest = 0;
+
+   for( index = 0; index < (int) sim.cores.size( ); index++ )
+   {
+      if( ( index != core ) && ( sim.cores[index].sched.ready.size( ) > longest ) )
+      {
+         longest = sim.cores[index].sched.ready.size( );
+         victim = index;
+      }
+   }
+
+   if( victim < 0 )
+   {
+      return -1;
+   }
+
+   sim.cores[core].steals++;
+   return pickReady( sim.cores[victim].sched );
+}
+
+/**
+ * @brief dispatchCore function.
+ *
+ * @details gives an idle core to the ready process its scheduler picks, or
+ *          to one stolen from another core.
+ *
+ * @param in: sim, core
+ *
+ * @note A process that immediately waits or ends hands the core on.
+ *       Switching to a different process than the core's last one costs
+ *       the context switch time before the process carries on.
+ */
+static void dispatchCore( simState &sim, int core )
+{
+   cpuCore &cpu = sim.cores[core];
+   int process = 0;
+   simTime now = 0;
+
+   while( cpu.running < 0 )
+   {
+      process = pickReady( cpu.sched );
+
+      if( process < 0 )
+      {
+         process = stealWork( sim, core );
+      }
+      if( process < 0 )
+      {
+         setIdle( sim, core, true );
+         return;
+      }
+
+      now = readClock( *sim.clock );
+      cpu.running = process;
+      sim.processes[process].core = core;
+      sim.processes[process].processState = RUNNING;
+      sim.processes[process].waitingTime = sim.processes[process].waitingTime +
+                                           ( now - sim.processes[process].readySince );
+
+      if( !sim.processes[process].started )
+      {
+         logNow( sim, PROCESS_START, process, -1, -1, 0 );
+         sim.processes[process].started = true;
+         sim.processes[process].firstRun = now;
+      }
+
+      if( ( cpu.lastRan >= 0 ) && ( cpu.lastRan != process ) )
+      {
+         cpu.switchCount++;
+
+         if( sim.switchTime > 0 )
+         {
+            cpu.lastRan = process;
+            cpu.inSlice = false;
+            cpu.opStart = now;
+            cpu.sliceTime = sim.switchTime;
+            pushCpuEvent( sim, SWITCH_DONE, process, now + sim.switchTime );
+            return;
+         }
+      }
+
+      cpu.lastRan = process;
+      continueProcess( sim, process );
+   }
+}
+
+/**
+ * @brief dispatch function.
+ *
+ * @details runs a dispatch pass on every core that went idle or got work
+ *          while idle.
+ *
+ * @param in: sim
+ *
+ * @note Cores with nothing new to do are not visited.
+ */
+static void dispatch( simState &sim )
+{
+   size_t index = 0;
+   int core = 0;
+
+   for( index = 0; index < sim.wakeList.size( ); index++ )
+   {
+      core = sim.wakeList[index];
+      sim.cores[core].awake = false;
+      dispatchCore( sim, core );
+   }
+
+   sim.wakeList.clear( );
+}
+
+/**
+ * @brief staleEvent function.
+ *
+ * @details true if a pending event belongs to a preempted slice.
+ *
+ * @param in: sim, event
+ *
+ * @note Only the cores' own events can go stale. The process may have
+ *       finished and its slot been reused since.
+ */
+static bool staleEvent( simState &sim, simEvent &event )
+{
+   int core = sim.processes[event.process].core;
+
+   return ( event.type != IO_DONE ) &&
+          ( ( core < 0 ) || ( event.sequence != sim.cores[core].cpuEvent ) );
+}
+
+/**
+ * @brief nextEvent function.
+ *
+ * @details waits for the next event.
+ *
+ * @param in: sim
+ *
+ * @param out: event
+ *
+ * @note Virtual time pops the pending-event set and moves the clock to
+ *       the event. Real time sleeps until the earliest pending event but
+ *       returns a device completion as soon as a worker posts one. Events
+ *       of preempted slices are dropped without moving the clock. Returns
+ *       false if nothing is left to wait for.
+ */
+static bool nextEvent( simState &sim, simEvent &event )
+{
+   bool hasDeadline = false;
+   simTime deadline = 0;
+   ioJob job;
+
+   while( peekEvent( sim.events, event ) && staleEvent( sim, event ) )
+   {
+      popEvent( sim.events, event );
+   }
+   hasDeadline = !emptyEventQueue( sim.events );
+
+   if( sim.clock->virtualTime )
+   {
+      if( !popEvent( sim.events, event ) )
+      {
+         return false;
+      }
+
+      advanceClock( *sim.clock, event.time );
+      return true;
+   }
+
+   if( !hasDeadline && ( sim.pool->outstanding == 0 ) )
+   {
+      return false;
+   }
+
+   if( hasDeadline )
+   {
+      deadline = nextEventTime( sim.events );
+   }
+
+   if( waitCompletion( *sim.pool, hasDeadline, deadline, job ) )
+   {
+      recordTiming( sim, job.process, job.duration, job.intended );
+      event.time = job.finished;
+      event.type = IO_DONE;
+      event.process = job.process;
+      event.unit = job.unit;
+      return true;
+   }
+
+   return popEvent( sim.events, event );
+}
+
+/**
+ * @brief startPageIn function.
+ *
+ * @details handles the running process's page fault by reading the page
+ *          from a hard drive unit.
+ *
+ * @param in: sim, process
+ *
+ * @note The read takes one hard drive cycle. Without a hard drive in the
+ *       config the page is loaded at once and the process keeps its core.
+ */
+static void startPageIn( simState &sim, int process )
+{
+   PCB &pcb = sim.processes[process];
+   unsigned int address = faultAddress( sim.paging, pcb.processID );
+   int unit = pickDeviceUnit( *sim.pool, sim.pagingDevice );
+
+   logNow( sim, PAGE_FAULT, process, -1, -1, address );
+   pcb.faultStart = readClock( *sim.clock );
+
+   if( unit >= 0 )
+   {
+      waitOnDevice( sim, process, unit, opDuration( sim, sim.pagingDevice, 1 ) );
+      return;
+   }
+
+   loadPage( sim.paging, pcb.processID, 0 );
+   logNow( sim, PAGE_LOADED, process, -1, -1, address );
+   pcb.pageFault = false;
+   pcb.pageRefs--;
+   startReferences( sim, process );
+}
+
+/**
+ * @brief finishCpuOp function.
+ *
+ * @details ends the running process's processing or memory operation, or
+ *          one slice of a processing action.
+ *
+ * @param in: sim, event
+ *
+ * @note The process keeps the processor and carries on unless the
+ *       scheduler preempts it at a slice boundary or the operation stopped
+ *       at a page fault.
+ */
+static void finishCpuOp( simState &sim, simEvent &event )
+{
+   int process = event.process;
+   PCB &pcb = sim.processes[process];
+   opRecord &op = pcb.ops[pcb.nextOp];
+   cpuCore &core = sim.cores[pcb.core];
+   unsigned int address = 0;
+
+   recordTiming( sim, process, core.sliceTime, core.opStart );
+   core.cpuEvent = -1;
+   core.inSlice = false;
+   core.busy = core.busy + ( readClock( *sim.clock ) - core.opStart );
+   pcb.remainingTime = max( pcb.remainingTime - core.sliceTime, (simTime) 0 );
+
+   if( op.code == OP_RUN )
+   {
+      pcb.opRemaining = pcb.opRemaining - core.sliceTime;
+
+      if( pcb.opRemaining > 0 )
+      {
+         if( shouldPreempt( core.sched, pcb ) )
+         {
+            logNow( sim, CPU_PREEMPT, process, -1, -1, 0 );
+            releaseCore( sim, process );
+            makeReady( sim, process );
+         }
+         else
+         {
+            startSlice( sim, process );
+         }
+         return;
+      }
+
+      logNow( sim, CPU_END, process, -1, -1, 0 );
+   }
+   else if( ( op.code == OP_ALLOCATE ) && ( sim.paging.stats.policy != NO_PAGING ) )
+   {
+      address = addPage( sim.paging, pcb.processID );
+      logNow( sim, MEMORY_ALLOCATED, process, -1, -1, address );
+   }
+   else if( op.code == OP_ALLOCATE )
+   {
+      if( allocateBlock( sim.memory, pcb.processID, address ) )
+      {
+         logNow( sim, MEMORY_ALLOCATED, process, -1, -1, address );
+      }
+      else
+      {
+         logNow( sim, MEMORY_FAILED, process, -1, -1, 0 );
+      }
+   }
+   else if( pcb.pageFault )
+   {
+      startPageIn( sim, process );
+      return;
+   }
+   else
+   {
+      logNow( sim, BLOCK_END, process, -1, -1, 0 );
+      pcb.pageRefs = -1;
+   }
+
+   pcb.nextOp++;
+   continueProcess( sim, process );
+}
+
+/**
+ * @brief preemptRunning function.
+ *
+ * @details takes a core from its running process in the middle of a
+ *          processing slice.
+ *
+ * @param in: sim, core
+ *
+ * @note The time already run is charged to the process and its slice event
+ *       is cancelled. A slice that has run out is left to end normally.
+ */
+static void preemptRunning( simState &sim, int core )
+{
+   cpuCore &cpu = sim.cores[core];
+   int process = cpu.running;
+   PCB &pcb = sim.processes[process];
+   simTime ranFor = readClock( *sim.clock ) - cpu.opStart;
+
+   if( ranFor >= cpu.sliceTime )
+   {
+      return;
+   }
+
+   cpu.cpuEvent = -1;
+   cpu.busy = cpu.busy + ranFor;
+   pcb.opRemaining = pcb.opRemaining - ranFor;
+   pcb.remainingTime = max( pcb.remainingTime - ranFor, (simTime) 0 );
+
+   logNow( sim, CPU_PREEMPT, process, -1, -1, 0 );
+   releaseCore( sim, process );
+   makeReady( sim, process );
+}
+
+/**
+ * @brief finishIO function.
+ *
+ * @details handles a device interrupt: ends a process's I/O operation or
+ *          page-in and makes it ready again.
+ *
+ * @param in: sim, event
+ *
+ * @note A page-in leaves the process in its M(block) operation. The woken
+ *       process preempts the processing slice running on the
+ *       core it was queued on if that core's scheduler says so.
+ */
+static void finishIO( simState &sim, simEvent &event )
+{
+   int process = event.process;
+   PCB &pcb = sim.processes[process];
+   opRecord &op = pcb.ops[pcb.nextOp];
+   deviceUnit *unit = sim.pool->units[event.unit];
+   unsigned int address = 0;
+   int core = 0;
+
+   if( pcb.pageFault )
+   {
+      address = faultAddress( sim.paging, pcb.processID );
+      loadPage( sim.paging, pcb.processID, readClock( *sim.clock ) - pcb.faultStart );
+      logNow( sim, PAGE_LOADED, process, unit->device, unit->number, address );
+      pcb.pageFault = false;
+      pcb.pageRefs--;
+   }
+   else
+   {
+      logNow( sim, ( op.code == OP_INPUT ) ? INPUT_END : OUTPUT_END, process, unit->device, unit->number, 0 );
+
+      pcb.remainingTime = max( pcb.remainingTime - op.duration, (simTime) 0 );
+      pcb.nextOp++;
+   }
+
+   core = makeReady( sim, process );
+   cpuCore &cpu = sim.cores[core];
+
+   if( ( cpu.running >= 0 ) && cpu.inSlice &&
+       interruptPreempts( cpu.sched, sim.processes[cpu.running], readClock( *sim.clock ) - cpu.opStart, pcb ) )
+   {
+      preemptRunning( sim, core );
+   }
+}
+
+/**
+ * @brief sequentialRun function.
+ *
+ * @details true if the simulation that is about to start cannot overlap
+ *          anything.
+ *
+ * @param in: sim
+ *
+ * @note That is a virtual time run without paging whose whole meta-data is
+ *       one application, waiting on the core it was queued on.
+ */
+static bool sequentialRun( simState &sim )
+{
+   return sim.clock->virtualTime && ( sim.paging.stats.policy == NO_PAGING ) &&
+          sim.feedDone && ( sim.remaining == 1 ) && ( sim.wakeList.size( ) == 1 );
+}
+
+/**
+ * @brief runSequential function.
+ *
+ * @details runs a lone process straight through its operations, without
+ *          the pending-event set.
+ *
+ * @param in: sim
+ *
+ * @note A lone process never waits for a core or is preempted, every
+ *       device unit is free when it asks for one, and each operation
+ *       starts when the one before it ends, so its times are a running sum
+ *       of its operation times. The log, the device pool, memory and the
+ *       figures come out as the event loop would give them. The sum costs
+ *       next to nothing; such a run's time goes on formatting its log.
+ */
+static void runSequential( simState &sim )
+{
+   int core = sim.wakeList[0];
+   cpuCore &cpu = sim.cores[core];
+   int process = pickReady( cpu.sched );
+   PCB &pcb = sim.processes[process];
+   simTime now = readClock( *sim.clock );
+   unsigned int address = 0;
+   int index = 0;
+   ioJob job;
+
+   sim.wakeList.clear( );
+   cpu.awake = false;
+   cpu.lastRan = process;
+   pcb.core = core;
+   pcb.processState = RUNNING;
+   pcb.started = true;
+   pcb.firstRun = now;
+   pcb.waitingTime = now - pcb.readySince;
+   logNow( sim, PROCESS_START, process, -1, -1, 0 );
+
+   for( index = 0; index < (int) pcb.ops.size( ); index++ )
+   {
+      opRecord &op = pcb.ops[index];
+
+      switch( op.code )
+      {
+         case OP_RUN:
+         case OP_ALLOCATE:
+         case OP_BLOCK:
+            if( op.code == OP_RUN )
+            {
+               logNow( sim, CPU_START, process, -1, coreInstance( sim, process ), 0 );
+            }
+            else
+            {
+               logNow( sim, ( op.code == OP_ALLOCATE ) ? MEMORY_ALLOCATE : BLOCK_START, process, -1, -1, 0 );
+            }
+
+            now = now + op.duration;
+            cpu.busy = cpu.busy + op.duration;
+            advanceClock( *sim.clock, now );
+
+            if( op.code == OP_RUN )
+            {
+               logNow( sim, CPU_END, process, -1, -1, 0 );
+            }
+            else if( op.code == OP_BLOCK )
+            {
+               logNow( sim, BLOCK_END, process, -1, -1, 0 );
+            }
+            else if( allocateBlock( sim.memory, pcb.processID, address ) )
+            {
+               logNow( sim, MEMORY_ALLOCATED, process, -1, -1, address );
+            }
+            else
+            {
+               logNow( sim, MEMORY_FAILED, process, -1, -1, 0 );
+            }
+            break;
+
+         case OP_INPUT:
+         case OP_OUTPUT:
+            job.unit = pickDeviceUnit( *sim.pool, op.device );
+
+            if( job.unit < 0 )
+            {
+               break;
+            }
+
+            logNow( sim, ( op.code == OP_INPUT ) ? INPUT_START : OUTPUT_START, process, op.device, -1, 0 );
+            job.process = process;
+            job.duration = op.duration;
+            submitIO( *sim.pool, job );
+
+            now = job.finished;
+            advanceClock( *sim.clock, now );
+            logNow( sim, ( op.code == OP_INPUT ) ? INPUT_END : OUTPUT_END, process,
+                    sim.pool->units[job.unit]->device, sim.pool->units[job.unit]->number, 0 );
+            break;
+
+         default:
+            break;
+      }
+   }
+
+   logNow( sim, PROCESS_REMOVE, process, -1, -1, 0 );
+   pcb.processState = EXIT;
+   pcb.finish = now;
+   pcb.nextOp = pcb.ops.size( );
+   retireProcess( sim, process );
+}
+
+/**
+ * @brief runSimulation function.
+ *
+ * @details runs the meta-data once and reports every event to the log sink,
+ *          which writes it to the monitor, the log file or both.
+ *
+ * @param in: feed, fileData, clock, sink, pool
+ *
+ * @param out: result
+ *
+ * @note Applications are prepared as the feed's resident limit allows;
+ *       without a limit every one is prepared at time zero. A process
+ *       starts the first time it gets a core. Waiting time is time spent
+ *       in the ready queue. A run that cannot overlap anything takes the
+ *       runSequential fast path instead of the event loop.
+ */
+void runSimulation( metaFeed &feed, configData &fileData, simClock &clock, logSink &sink, devicePool &pool, simResult &result )
+{
+   int index = 0;
+   int unit = 0;
+   int policy = FIFO_POLICY;
+   int quantumNumber = fileData.quantumNumber;
+   int coreCount = max( fileData.processorCores, 1 );
+   simTime quantum = 0;
+   simState sim;
+   simEvent event;
+
+   sim.feed = &feed;
+   sim.fileData = &fileData;
+   sim.clock = &clock;
+   sim.sink = &sink;
+   sim.pool = &pool;
+   sim.processorDevice = findComponent( fileData, "Processor" );
+   initMemory( sim.memory, findMemoryPolicy( fileData.memoryCode ), fileData.systemMemorySize, fileData.blockMemorySize );
+   initPager( sim.paging, findReplacementPolicy( fileData.pagingCode ), fileData.systemMemorySize,
+              fileData.blockMemorySize, fileData.tlbEntries, coreCount );
+   sim.pagingDevice = findComponent( fileData, "Hard drive" );
+   sim.admitted = 0;
+   sim.remaining = 0;
+   sim.feedDone = false;
+   sim.pendingStart = false;
+   sim.totalTurnaround = 0;
+   sim.maxTurnaround = 0;
+   sim.totalWaiting = 0;
+   sim.maxWaiting = 0;
+   sim.totalResponse = 0;
+   sim.maxResponse = 0;
+   sim.totalDrift = 0;
+   sim.maxDrift = 0;
+   sim.switchTime = (simTime) fileData.contextSwitchTime * USEC_PER_MSEC;
+
+   if( !fileData.schedulingCode.empty( ) )
+   {
+      policy = findPolicy( fileData.schedulingCode );
+   }
+   if( quantumNumber <= 0 )
+   {
+      quantumNumber = 1;
+   }
+   if( sim.processorDevice >= 0 )
+   {
+      quantum = opDuration( sim, sim.processorDevice, quantumNumber );
+   }
+
+   sim.cores.resize( coreCount );
+   for( index = 0; index < coreCount; index++ )
+   {
+      cpuCore &core = sim.cores[index];
+
+      core.running = -1;
+      initScheduler( core.sched, policy, quantum );
+      core.opStart = 0;
+      core.sliceTime = 0;
+      core.cpuEvent = -1;
+      core.inSlice = false;
+      core.lastRan = -1;
+      core.idleSlot = -1;
+      core.awake = false;
+      core.busy = 0;
+      core.switchCount = 0;
+      core.steals = 0;
+      setIdle( sim, index, true );
+   }
+   initEventQueue( sim.events );
+
+   startClock( clock );
+   logNow( sim, SIM_START, -1, -1, -1, 0 );
+   admitProcesses( sim );
+
+   if( sequentialRun( sim ) )
+   {
+      runSequential( sim );
+   }
+
+   while( sim.remaining > 0 )
+   {
+      dispatch( sim );
+
+      if( sim.remaining > 0 )
+      {
+         if( !nextEvent( sim, event ) )
+         {
+            break;
+         }
+
+         if( event.type == CPU_DONE )
+         {
+            finishCpuOp( sim, event );
+         }
+         else if( event.type == SWITCH_DONE )
+         {
+            cpuCore &core = sim.cores[sim.processes[event.process].core];
+
+            recordTiming( sim, event.process, core.sliceTime, core.opStart );
+            core.cpuEvent = -1;
+            continueProcess( sim, event.process );
+         }
+         else
+         {
+            finishIO( sim, event );
+         }
+      }
+
+      admitProcesses( sim );
+   }
+
+   result.processCount = sim.admitted;
+   result.makespan = readClock( clock );
+   result.cpuBusy = 0;
+   result.policy = policy;
+   result.quantum = quantum;
+   result.totalTurnaround = sim.totalTurnaround;
+   result.maxTurnaround = sim.maxTurnaround;
+   result.totalWaiting = sim.totalWaiting;
+   result.maxWaiting = sim.maxWaiting;
+   result.totalResponse = sim.totalResponse;
+   result.maxResponse = sim.maxResponse;
+   result.switchCount = 0;
+   result.switchTime = sim.switchTime;
+   result.virtualTime = clock.virtualTime;
+   result.totalDrift = sim.totalDrift;
+   result.maxDrift = sim.maxDrift;
+   result.memory = sim.memory.stats;
+   result.paging = sim.paging.stats;
+   result.coreBusy.clear( );
+   result.coreSteals.clear( );
+
+   for( index = 0; index < coreCount; index++ )
+   {
+      result.cpuBusy = result.cpuBusy + sim.cores[index].busy;
+      result.switchCount = result.switchCount + sim.cores[index].switchCount;
+      result.coreBusy.push_back( sim.cores[index].busy );
+      result.coreSteals.push_back( sim.cores[index].steals );
+   }
+
+   result.deviceBusy.assign( pool.unitCount.size( ), 0 );
+
+   for( index = 0; index < (int) pool.unitCount.size( ); index++ )
+   {
+      for( unit = 0; unit < pool.unitCount[index]; unit++ )
+      {
+         result.deviceBusy[index] = result.deviceBusy[index] + pool.units[pool.firstUnit[index] + unit]->busyTime;
+      }
+   }
+}
+
+/**
+ * @brief printSimulationSummary function.
+ *
+ * @details prints the whole-run figures to the monitor.
+ *
+ * @param in: result
+ *
+ * @note Process drift, how much longer a process's operations took in all
+ *       than their cycles asked for, only means something in real time.
+ */
+void printSimulationSummary( simResult &result )
+{
+   double utilization = 0.0;
+   double coreUtilization = 0.0;
+   int index = 0;
+   int coreCount = result.coreBusy.size( );
+   double meanTurnaround = 0.0;
+   double meanWaiting = 0.0;
+   double meanResponse = 0.0;
+   streamsize oldPrecision = cout.precision( );
+
+   if( ( result.makespan > 0 ) && ( coreCount > 0 ) )
+   {
+      utilization = (double) result.cpuBusy / result.makespan / coreCount;
+   }
+   if( result.processCount > 0 )
+   {
+      meanTurnaround = toSeconds( result.totalTurnaround ) / result.processCount;
+      meanWaiting = toSeconds( result.totalWaiting ) / result.processCount;
+      meanResponse = toSeconds( result.totalResponse ) / result.processCount;
+   }
+
+   cout << fixed << setprecision(3);
+   cout << "CPU scheduling: " << policyName( result.policy );
+   if( ( result.policy == RR_POLICY ) || ( result.policy == SRTF_POLICY ) )
+   {
+      cout << ", quantum " << toSeconds( result.quantum ) << " sec";
+   }
+   cout << endl;
+   cout << "Processes: " << result.processCount << endl;
+   cout << "Makespan (sec): " << toSeconds( result.makespan ) << endl;
+   cout << "CPU utilization: " << utilization << endl;
+
+   if( coreCount > 1 )
+   {
+      for( index = 0; index < coreCount; index++ )
+      {
+         coreUtilization = ( result.makespan > 0 ) ? (double) result.coreBusy[index] / result.makespan : 0.0;
+         cout << "Core " << index << ": busy " << toSeconds( result.coreBusy[index] ) << " sec, utilization "
+              << coreUtilization << ", steals " << result.coreSteals[index] << endl;
+      }
+   }
+
+   cout << "Turnaround mean/max (sec): " << meanTurnaround << " / " << toSeconds( result.maxTurnaround ) << endl;
+   cout << "Waiting mean/max (sec): " << meanWaiting << " / " << toSeconds( result.maxWaiting ) << endl;
+   cout << "Response mean/max (sec): " << meanResponse << " / " << toSeconds( result.maxResponse ) << endl;
+   cout << "Context switches: " << result.switchCount
+        << ", overhead " << toSeconds( result.switchCount * result.switchTime ) << " sec" << endl;
+
+   if( !result.virtualTime && ( result.processCount > 0 ) )
+   {
+      cout << "Process drift mean/max (sec): " << toSeconds( result.totalDrift ) / result.processCount
+           << " / " << toSeconds( result.maxDrift ) << endl;
+   }
+   cout.unsetf( ios::floatfield );
+   cout.precision( oldPrecision );
+
+   if( result.memory.policy != MODULO_FIT )
+   {
+      printMemorySummary( result.memory );
+   }
+
+   if( result.paging.policy != NO_PAGING )
+   {
+      printPagingSummary( result.paging, result.processCount );
+   }
+}
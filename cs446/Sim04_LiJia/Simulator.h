@@ -0,0 +1,82 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file Simulator.h
+ *
+ * @brief Simulation engine for the CS 446/646 operating system simulator.
+ *
+ * @details Runs the applications of the meta-data file as processes on the
+ *          processor's cores. A process keeps its core for its processing
+ *          and memory operations; when it starts an I/O operation it waits
+ *          on the device and the process the core's scheduler picks runs
+ *          next, so I/O overlaps with other processes' work and with I/O on
+ *          other device units. Each core has its own run queue, and a core
+ *          with an empty queue steals work from the busiest one.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "data.h"
+#include "SimClock.h"
+#include "LogSink.h"
+#include "DevicePool.h"
+#include "MetaStream.h"
+#include "MemoryManager.h"
+#include "Pager.h"
+
+using namespace std;
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct simResult
+{
+   int processCount;
+   simTime makespan;
+   simTime cpuBusy;
+
+   int policy;
+   simTime quantum;
+   simTime totalTurnaround;
+   simTime maxTurnaround;
+   simTime totalWaiting;
+   simTime maxWaiting;
+   simTime totalResponse;
+   simTime maxResponse;
+   long long switchCount;
+   simTime switchTime;
+
+   // real time only: operation time lost to the clock, per process
+   bool virtualTime;
+   simTime totalDrift;
+   simTime maxDrift;
+
+   vector<simTime> coreBusy;
+   vector<long long> coreSteals;
+
+   // per config device, the busy time of all its units together
+   vector<simTime> deviceBusy;
+
+   memoryStats memory;
+   pagingStats paging;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+int findComponent( configData &fileData, const char name[] );
+
+void runSimulation( metaFeed &feed, configData &fileData, simClock &clock, logSink &sink, devicePool &pool, simResult &result );
+
+void printSimulationSummary( simResult &result );
+
+#endif // SIMULATOR_H
@@ -0,0 +1,348 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file Workload.cpp
+ *
+ * @brief Synthetic meta-data generator implementation for the CS 446/646
+ *        operating system simulator.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include "Workload.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+static const char *INPUT_DEVICES[] = { "hard drive", "keyboard", "mouse" };
+
+static const char *OUTPUT_DEVICES[] = { "hard drive", "printer", "monitor", "speaker" };
+
+// operations per line of the file, as in the sample meta-data
+static const int OPS_PER_LINE = 6;
+
+// largest cycle count an exponential draw gives
+static const int MAX_CYCLES = 1000000;
+
+// bytes of output buffered before each write
+static const size_t WRITE_BUFFER = 1 << 20;
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct workloadWriter
+{
+   FILE *out;
+   vector<char> buffer;
+   size_t length;
+   int onLine;
+   bool failed;
+};
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief defaultWorkload function.
+ *
+ * @details sets the spec to the default workload of ops operations.
+ *
+ * @param in: spec, ops
+ *
+ * @note Twenty operations per application, half of them processing, and
+ *       uniform cycle counts from 1 to 20 like the sample files.
+ */
+void defaultWorkload( workloadSpec &spec, long long ops )
+{
+   spec.ops = ops;
+   spec.processes = max( ops / 20, 1LL );
+   spec.mix[MIX_RUN] = 50;
+   spec.mix[MIX_ALLOCATE] = 10;
+   spec.mix[MIX_BLOCK] = 10;
+   spec.mix[MIX_INPUT] = 15;
+   spec.mix[MIX_OUTPUT] = 15;
+   spec.distribution = UNIFORM_CYCLES;
+   spec.minCycles = 1;
+   spec.maxCycles = 20;
+   spec.meanCycles = 10;
+   spec.seed = 1;
+}
+
+/**
+ * @brief parseMix function.
+ *
+ * @details reads operation weights given as run,allocate,block,input,output.
+ *
+ * @param in: spec, text
+ *
+ * @note Returns false unless there are five non-negative weights that are
+ *       not all zero.
+ */
+bool parseMix( workloadSpec &spec, const char text[] )
+{
+   int weights[MIX_KINDS];
+   int total = 0;
+   int index = 0;
+   const char *next = text;
+   char *end = NULL;
+
+   for( index = 0; index < MIX_KINDS; index++ )
+   {
+      weights[index] = strtol( next, &end, 10 );
+
+      if( ( end == next ) || ( weights[index] < 0 ) ||
+          ( *end != ( ( index == MIX_KINDS - 1 ) ? '\0' : ',' ) ) )
+      {
+         return false;
+      }
+
+      total = total + weights[index];
+      next = end + 1;
+   }
+
+   if( total <= 0 )
+   {
+      return false;
+   }
+
+   memcpy( spec.mix, weights, sizeof( weights ) );
+   return true;
+}
+
+/**
+ * @brief parseCycles function.
+ *
+ * @details reads a cycle count distribution: fixed:N, uniform:MIN-MAX or
+ *          exp:MEAN.
+ *
+ * @param in: spec, text
+ *
+ * @note Counts are at least 1. Returns false for anything else.
+ */
+bool parseCycles( workloadSpec &spec, const char text[] )
+{
+   int low = 0;
+   int high = 0;
+   double mean = 0;
+   char extra = '\0';
+
+   if( sscanf( text, "fixed:%d%c", &low, &extra ) == 1 )
+   {
+      high = low;
+      spec.distribution = FIXED_CYCLES;
+   }
+   else if( sscanf( text, "uniform:%d-%d%c", &low, &high, &extra ) == 2 )
+   {
+      spec.distribution = UNIFORM_CYCLES;
+   }
+   else if( ( sscanf( text, "exp:%lf%c", &mean, &extra ) == 1 ) && ( mean >= 1 ) )
+   {
+      spec.distribution = EXPONENTIAL_CYCLES;
+      spec.meanCycles = mean;
+      return true;
+   }
+   else
+   {
+      return false;
+   }
+
+   if( ( low < 1 ) || ( high < low ) )
+   {
+      return false;
+   }
+
+   spec.minCycles = low;
+   spec.maxCycles = high;
+   return true;
+}
+
+/**
+ * @brief nextRandom function.
+ *
+ * @details next 31 bit value of the generator.
+ *
+ * @param in: state
+ *
+ * @note N/A.
+ */
+static unsigned int nextRandom( unsigned long long &state )
+{
+   state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+
+   return (unsigned int) ( state >> 33 );
+}
+
+/**
+ * @brief drawCycles function.
+ *
+ * @details draws one cycle count.
+ *
+ * @param in: spec, state
+ *
+ * @note N/A.
+ */
+static int drawCycles( const workloadSpec &spec, unsigned long long &state )
+{
+   double uniform = 0;
+   double cycles = 0;
+
+   switch( spec.distribution )
+   {
+      case UNIFORM_CYCLES:
+         return spec.minCycles + nextRandom( state ) % ( spec.maxCycles - spec.minCycles + 1 );
+
+      case EXPONENTIAL_CYCLES:
+         uniform = ( nextRandom( state ) + 0.5 ) / 2147483648.0;
+         cycles = ceil( -spec.meanCycles * log( uniform ) );
+         return (int) min( max( cycles, 1.0 ), (double) MAX_CYCLES );
+
+      default:
+         return spec.minCycles;
+   }
+}
+
+/**
+ * @brief emitOp function.
+ *
+ * @details appends one operation to the output.
+ *
+ * @param in: writer, code, name, cycles
+ *
+ * @note Writes the buffer out when it fills, and starts a new line every
+ *       OPS_PER_LINE operations.
+ */
+static void emitOp( workloadWriter &writer, char code, const char name[], int cycles )
+{
+   char *at = NULL;
+   size_t nameLength = strlen( name );
+
+   if( writer.length + nameLength + 32 > writer.buffer.size( ) )
+   {
+      if( fwrite( &writer.buffer[0], 1, writer.length, writer.out ) != writer.length )
+      {
+         writer.failed = true;
+      }
+      writer.length = 0;
+   }
+
+   at = &writer.buffer[writer.length];
+   *at++ = code;
+   *at++ = '(';
+   memcpy( at, name, nameLength );
+   at = at + nameLength;
+   *at++ = ')';
+   writer.length = at - &writer.buffer[0];
+   writer.length += snprintf( at, 16, "%d; ", cycles );
+   writer.onLine++;
+
+   if( writer.onLine == OPS_PER_LINE )
+   {
+      writer.buffer[writer.length++] = '\n';
+      writer.onLine = 0;
+   }
+}
+
+/**
+ * @brief writeWorkload function.
+ *
+ * @details writes the meta-data file a spec describes.
+ *
+ * @param in: spec, out
+ *
+ * @note The operations are split as evenly as they go over the
+ *       applications, none of which is left empty. Returns false if the
+ *       file could not be written.
+ */
+bool writeWorkload( const workloadSpec &spec, FILE *out )
+{
+   workloadWriter writer;
+   unsigned long long state = spec.seed;
+   long long processes = min( max( spec.processes, 1LL ), max( spec.ops, 1LL ) );
+   long long process = 0;
+   long long count = 0;
+   int total = 0;
+   int pick = 0;
+   int kind = 0;
+
+   writer.out = out;
+   writer.buffer.resize( WRITE_BUFFER );
+   writer.length = 0;
+   writer.onLine = 0;
+   writer.failed = false;
+
+   for( kind = 0; kind < MIX_KINDS; kind++ )
+   {
+      total = total + spec.mix[kind];
+   }
+
+   fputs( "Start Program Meta-Data Code:\n", out );
+   emitOp( writer, 'S', "start", 0 );
+
+   for( process = 0; process < processes; process++ )
+   {
+      emitOp( writer, 'A', "start", 0 );
+
+      for( count = spec.ops / processes + ( process < spec.ops % processes ); count > 0; count-- )
+      {
+         pick = nextRandom( state ) % total;
+
+         for( kind = 0; pick >= spec.mix[kind]; kind++ )
+         {
+            pick = pick - spec.mix[kind];
+         }
+
+         switch( kind )
+         {
+            case MIX_RUN:
+               emitOp( writer, 'P', "run", drawCycles( spec, state ) );
+               break;
+
+            case MIX_ALLOCATE:
+               emitOp( writer, 'M', "allocate", drawCycles( spec, state ) );
+               break;
+
+            case MIX_BLOCK:
+               emitOp( writer, 'M', "block", drawCycles( spec, state ) );
+               break;
+
+            case MIX_INPUT:
+               pick = nextRandom( state ) % ( sizeof( INPUT_DEVICES ) / sizeof( INPUT_DEVICES[0] ) );
+               emitOp( writer, 'I', INPUT_DEVICES[pick], drawCycles( spec, state ) );
+               break;
+
+            default:
+               pick = nextRandom( state ) % ( sizeof( OUTPUT_DEVICES ) / sizeof( OUTPUT_DEVICES[0] ) );
+               emitOp( writer, 'O', OUTPUT_DEVICES[pick], drawCycles( spec, state ) );
+               break;
+         }
+      }
+
+      emitOp( writer, 'A', "end", 0 );
+   }
+
+   emitOp( writer, 'S', "end", 0 );
+
+   if( ( writer.length > 0 ) && ( fwrite( &writer.buffer[0], 1, writer.length, out ) != writer.length ) )
+   {
+      writer.failed = true;
+   }
+
+   if( writer.onLine > 0 )
+   {
+      fputs( "\n", out );
+   }
+
+   fputs( "End Program Meta-Data Code.\n", out );
+   fflush( out );
+
+   return !writer.failed && !ferror( out );
+}
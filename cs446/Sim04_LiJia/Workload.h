@@ -0,0 +1,79 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file Workload.h
+ *
+ * @brief Synthetic meta-data generator for the CS 446/646 operating system
+ *        simulator.
+ *
+ * @details Writes a .mdf file of a chosen number of operations split over a
+ *          chosen number of applications. Each operation is drawn from a
+ *          weighted mix of P(run), M(allocate), M(block), I() and O(), with
+ *          the devices of the sample meta-data files, and its cycle count
+ *          from a fixed, uniform or exponential distribution. The generator
+ *          is a 64 bit LCG, so a seed gives the same file on any machine.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+enum cycleDistribution
+{
+   FIXED_CYCLES,
+   UNIFORM_CYCLES,
+   EXPONENTIAL_CYCLES
+};
+
+// operation kinds of the mix, in --mix order
+enum workloadOp
+{
+   MIX_RUN,
+   MIX_ALLOCATE,
+   MIX_BLOCK,
+   MIX_INPUT,
+   MIX_OUTPUT,
+   MIX_KINDS
+};
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct workloadSpec
+{
+   long long ops;
+   long long processes;
+   int mix[MIX_KINDS];
+
+   int distribution;
+   int minCycles;
+   int maxCycles;
+   double meanCycles;
+
+   unsigned long long seed;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+void defaultWorkload( workloadSpec &spec, long long ops );
+
+bool parseMix( workloadSpec &spec, const char text[] );
+
+bool parseCycles( workloadSpec &spec, const char text[] );
+
+bool writeWorkload( const workloadSpec &spec, FILE *out );
+
+#endif // WORKLOAD_H
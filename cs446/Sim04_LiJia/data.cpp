@@ -25,87 +25,148 @@
 #include <iostream> 
 #include <iomanip>
 #include <fstream> 
+#include <sstream>
 #include <string>
 #include <cstring>
 #include <cstdlib>
 #include <vector>
 #include <pthread.h>
+#include "data.h"
 #include "MemoryFunction.h"
+#include "SimClock.h"
+#include "LogSink.h"
+#include "DevicePool.h"
+#include "Simulator.h"
+#include "Scheduler.h"
+#include "MappedFile.h"
+#include "MetaStream.h"
+#include "MetaCache.h"
+#include "MemoryManager.h"
+#include "Pager.h"
 #include <ctime>
-#include <sys/time.h>
-#include <semaphore.h>
+#include <cerrno>
+#include <atomic>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/stat.h>
 
 using namespace std; 
 
-// Global Constants //////////////////////////////////////////////////////
+// Global constants ///////////////////////////////////////////////////////////
 
-const int START = 1; 
-const int READY = 2; 
-const int RUNNING = 3; 
-const int WAITING = 4; 
-const int EXIT = 5;
+// most combinations one sweep may run
+const long long MAX_SWEEP_POINTS = 100000;
 
+// config entries other than the per-device cycle times and quantities
+enum configField
+{
+   KEY_VERSION,
+   KEY_FILE_PATH,
+   KEY_LOG,
+   KEY_LOG_PATH,
+   KEY_SYSTEM_MEMORY,
+   KEY_BLOCK_SIZE,
+   KEY_SCHEDULING,
+   KEY_MEMORY_POLICY,
+   KEY_PAGING,
+   KEY_TLB,
+   KEY_QUANTUM,
+   KEY_CORES,
+   KEY_SWITCH_TIME
+};
 
-sem_t mutex;
-
-// Structures //////////////////////////////////////////////////////
+struct configKey
+{
+   const char *key;
+   int field;
+};
 
-struct threadData
+const configKey CONFIG_KEYS[] =
 {
-	struct timeval t1;
-   struct timeval t2;
-   float cycleTime2; 
+   { "Version/Phase", KEY_VERSION },
+   { "File Path", KEY_FILE_PATH },
+   { "Log", KEY_LOG },
+   { "Log File Path", KEY_LOG_PATH },
+   { "System memory", KEY_SYSTEM_MEMORY },
+   { "Memory block size", KEY_BLOCK_SIZE },
+   { "CPU Scheduling Code", KEY_SCHEDULING },
+   { "Memory Allocation Code", KEY_MEMORY_POLICY },
+   { "Page Replacement Code", KEY_PAGING },
+   { "TLB entries", KEY_TLB },
+   { "Processor Quantum Number", KEY_QUANTUM },
+   { "Processor cores", KEY_CORES },
+   { "Context switch time", KEY_SWITCH_TIME }
 };
 
-struct PCB 
+// Structures /////////////////////////////////////////////////////////////////
+
+// a meta-data file of a batch, mapped once from its .mdb cache when it has
+// one and shared by every job that runs it
+struct batchWorkload
 {
-   int processState; 
+   string path;
+   metaCache cache;
+   bool cached;
 };
 
-struct cycleTime 
+struct batchJob
 {
-   string componentName; 
-   int time; 
+   string configFile;
+   string metaFile;
+   string outFile;
+
+   configData fileData;
+   int workload;
+
+   // "ok", or the step that failed
+   string status;
+   simResult result;
+   double wallSeconds;
 };
 
-struct logInfo
+struct batchRun
 {
-   string logCriteria; 
-   char logFilePath[30]; 
+   vector<batchJob> jobs;
+   vector<batchWorkload> workloads;
+
+   bool virtualTime;
+   simTime spinTime;
+   int residentLimit;
+
+   // next job a worker thread takes
+   atomic<int> nextJob;
 };
 
-struct configData
+// one --sweep parameter: a config key and the values it takes in turn
+struct sweepParameter
 {
-   char filePath[30]; 
-   float versionNum;
-   cycleTime cycleData[8];
-   logInfo logData; 
-   int printerQuantity; 
-   int hardDriveQuantity; 
-   int systemMemorySize;
-   int blockMemorySize; 
+   string key;
+   vector<string> values;
 };
 
-struct metaData
+// a what-if session: its one job holds the config and figures of the last
+// answer, and its workload stays mapped between answers
+struct whatIfSession
 {
-   char code;
-   char description[30]; 
-   int cycles; 
+   batchRun batch;
+   metaProfile profile;
+   bool profiled;
+   bool answered;
 };
 
 // Function definitions //////////////////////////////////////////////////////
 
 void readConfigData( configData &fileData, char fileName[], bool &readFlag );
 
-void readMetaData( vector<metaData> &metaDataStream, configData &fileData, char filePath[] );
+bool readMetaData( vector<opRecord> &metaDataStream, configData &fileData, const char filePath[], bool writeCache );
 
-void printMetrics( vector<metaData> &metaDataStream, configData &fileData, PCB &processObj ); 
- 
-void outputToFileMetrics( vector<metaData> &metaDataStream, configData &fileData, PCB &processObj );
+bool runBatch( const char manifest[], const char outDir[], int workers, bool useCache,
+               bool virtualTime, simTime spinTime, int residentLimit );
+
+bool runSweep( char configFile[], const vector<char *> &sweeps, int workers, bool useCache, int residentLimit );
 
-double findTime( struct timeval t1, struct timeval t2 ); 
+bool runWhatIf( char configFile[], bool useCache, int residentLimit );
 
-void wait( struct timeval t1, struct timeval t2, double cycleTime1 ); 
 
 // Function implementations  //////////////////////////////////////////////////////
 
@@ -116,40 +177,222 @@ void wait( struct timeval t1, struct timeval t2, double cycleTime1 );
  *          
  * @param in: argv, argv[]
  *
- * @note Checks for the number of command-line arguments.  
+ * @note Checks for the number of command-line arguments. The optional
+ *       --virtual-time flag computes every timestamp from a simulated
+ *       clock instead of waiting in real time. --spin-us N busy waits the
+ *       last N microseconds of each real wait, and --summary prints the
+ *       run summary after the simulation. --stream parses the meta-data on
+ *       a separate thread while the simulation runs; it is also used when
+ *       the meta-data file path is "-" (standard input) or a FIFO.
+ *       --resident N caps the processes prepared at once, which defaults
+ *       to STREAM_RESIDENT when streaming and to no limit otherwise.
+ *       Unless --no-cache is given, a meta-data file that is read whole is
+ *       taken from its .mdb cache when that is current and written to it
+ *       when not. --trace FILE records the log as a binary trace in FILE
+ *       instead, for simtrace to decode. --parse-only reads the config and
+ *       the whole meta-data file, without its cache, and stops there; it is
+ *       what simbench times the parser with. --batch MANIFEST runs every
+ *       job of a manifest instead of one config, on --jobs N threads, with
+ *       the logs and summary.csv in --out DIR (see runBatch). Each
+ *       --sweep "KEY=VALUES" varies one config entry, and every
+ *       combination of them is run on the config in virtual time, with
+ *       one CSV row per point written out (see runSweep). --what-if
+ *       runs the config once and then answers config lines read from
+ *       standard input with the summary of the changed config (see
+ *       runWhatIf).
  */
 int main( int argc, char* argv[] )
 {
-   configData fileData; 
-   vector<metaData> metaDataStream; 
+   configData fileData = configData( ); 
+   vector<opRecord> metaDataStream; 
    bool readFlag = true;
-   int size = 0;
+   bool virtualTime = false;
+   bool summary = false;
+   bool stream = false;
+   bool feedOpen = false;
+   bool useCache = true;
+   bool parseOnly = false;
+   bool whatIf = false;
+   int residentLimit = -1;
+   struct stat info;
+   simTime spinTime = 0;
+   char *configFile = NULL;
+   char *traceFile = NULL;
+   char *batchFile = NULL;
+   vector<char *> sweeps;
+   const char *outDir = "batch";
+   int workers = 0;
    int index = 0;
-   PCB processObj; 
+   simClock clock;
+   logSink sink = logSink( );
+   devicePool pool;
+   simResult result = simResult( );
+   metaFeed feed;
+   metaCache cache = metaCache( );
+
+   for( index = 1; index < argc; index++ )
+   {
+      if( strcmp( argv[index], "--virtual-time" ) == 0 )
+      {
+         virtualTime = true;
+      }
+      else if( strcmp( argv[index], "--summary" ) == 0 )
+      {
+         summary = true;
+      }
+      else if( strcmp( argv[index], "--stream" ) == 0 )
+      {
+         stream = true;
+      }
+      else if( strcmp( argv[index], "--no-cache" ) == 0 )
+      {
+         useCache = false;
+      }
+      else if( strcmp( argv[index], "--parse-only" ) == 0 )
+      {
+         parseOnly = true;
+      }
+      else if( strcmp( argv[index], "--what-if" ) == 0 )
+      {
+         whatIf = true;
+      }
+      else if( ( strcmp( argv[index], "--trace" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         index++;
+         traceFile = argv[index];
+      }
+      else if( ( strcmp( argv[index], "--batch" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         index++;
+         batchFile = argv[index];
+      }
+      else if( ( strcmp( argv[index], "--sweep" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         index++;
+         sweeps.push_back( argv[index] );
+      }
+      else if( ( strcmp( argv[index], "--jobs" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         index++;
+         workers = atoi( argv[index] );
+      }
+      else if( ( strcmp( argv[index], "--out" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         index++;
+         outDir = argv[index];
+      }
+      else if( ( strcmp( argv[index], "--resident" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         index++;
+         residentLimit = atoi( argv[index] );
+      }
+      else if( ( strcmp( argv[index], "--spin-us" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         index++;
+         spinTime = atoll( argv[index] );
+      }
+      else if( configFile == NULL )
+      {
+         configFile = argv[index];
+      }
+      else
+      {
+         configFile = NULL;
+         break;
+      }
+   }
    
-   if( ( argc < 2 ) || ( argc > 2 ) )
-      cout << "You either have too few command line arguments or too much. Abort.\n"; 
+   if( ( ( configFile == NULL ) == ( batchFile == NULL ) ) || ( ( batchFile != NULL ) && !sweeps.empty( ) ) ||
+       ( whatIf && ( ( batchFile != NULL ) || !sweeps.empty( ) ) ) )
+   {
+      cout << "Usage: Sim04 [--virtual-time] [--spin-us N] [--summary] [--stream] [--resident N] [--no-cache] [--trace FILE] [--parse-only] <config file>\n"
+           << "       Sim04 [--virtual-time] [--spin-us N] [--resident N] [--no-cache] [--jobs N] [--out DIR] --batch <manifest>\n"
+           << "       Sim04 [--resident N] [--no-cache] [--jobs N] --sweep KEY=VALUES [--sweep KEY=VALUES ...] <config file>\n"
+           << "       Sim04 [--resident N] [--no-cache] --what-if <config file>. Abort.\n"; 
+   }
+   else if( batchFile != NULL )
+   {
+      if( runBatch( batchFile, outDir, workers, useCache, virtualTime, spinTime, residentLimit ) == false )
+      {
+         return 1;
+      }
+   }
+   else if( whatIf == true )
+   {
+      if( runWhatIf( configFile, useCache, residentLimit ) == false )
+      {
+         return 1;
+      }
+   }
+   else if( !sweeps.empty( ) )
+   {
+      if( runSweep( configFile, sweeps, workers, useCache, residentLimit ) == false )
+      {
+         return 1;
+      }
+   }
    else
    {
-      readConfigData( fileData, argv[1], readFlag );
-      if( readFlag == true )
+      readConfigData( fileData, configFile, readFlag );
+      if( ( readFlag == true ) && ( parseOnly == true ) )
+      {
+         readMetaData( metaDataStream, fileData, fileData.filePath.c_str( ), false );
+      }
+      else if( readFlag == true )
       {
-         readMetaData( metaDataStream, fileData, fileData.filePath );
-			
-         if( fileData.logData.logCriteria.compare("Both") == 0 )
-         { 
-            printMetrics( metaDataStream, fileData, processObj );
-            outputToFileMetrics( metaDataStream, fileData, processObj );
+         if( ( fileData.filePath.compare( "-" ) == 0 ) ||
+             ( ( stat( fileData.filePath.c_str( ), &info ) == 0 ) && !S_ISREG( info.st_mode ) ) )
+         {
+            stream = true;
+         }
+
+         if( stream == true )
+         {
+            if( residentLimit < 0 )
+            {
+               residentLimit = STREAM_RESIDENT;
+            }
+            feedOpen = openStreamFeed( feed, fileData, fileData.filePath.c_str( ), residentLimit );
+         }
+         else if( ( useCache == true ) && ( loadMetaCache( cache, fileData, fileData.filePath.c_str( ) ) == true ) )
+         {
+            openCachedFeed( feed, cache, residentLimit );
+            feedOpen = true;
+         }
+         else
+         {
+            readMetaData( metaDataStream, fileData, fileData.filePath.c_str( ), useCache );
+            openBatchFeed( feed, metaDataStream, residentLimit );
+            feedOpen = true;
+         }
+
+         initClock( clock, virtualTime, spinTime );
+         startDevicePool( pool, clock, fileData );
+
+         if( ( feedOpen == true ) && ( openLogSink( sink, fileData, traceFile ) == true ) )
+         {
+            runSimulation( feed, fileData, clock, sink, pool, result );
          }
-         else if( fileData.logData.logCriteria.compare("File") == 0 )
+
+         closeLogSink( sink );
+
+         if( feedOpen == true )
          {
-            outputToFileMetrics( metaDataStream, fileData, processObj );
+            closeFeed( feed );
          }
-         else if( fileData.logData.logCriteria.compare("Monitor") == 0 )
+
+         unloadMetaCache( cache );
+
+         if( summary == true )
          {
-            printMetrics( metaDataStream, fileData, processObj );
+            cout << "Run summary" << endl;
+            printSimulationSummary( result );
+            printClockSummary( clock );
+            printDevicePoolSummary( pool, result.makespan );
          }
-         
+
+         stopDevicePool( pool );
+         destroyClock( clock );
       }  
 
    }
@@ -158,780 +401,1436 @@ int main( int argc, char* argv[] )
 }
 
 /**
- * @brief readConfigData function.
+ * @brief registerDevice function.
  *
- * @details reads in config data from the config file. 
- *          
- * @param in: fileData, fileName, readFlag
+ * @details finds a device type in the registry, adding it if it is new.
  *
- * @note Accepts file name from the parameter. Then parse the string
- *       with the stream ignore function to read in the components of 
- *       operating system management and their cycle values. 
- *       Checks for empty file and incorrect
- *       filenames. In addition, the function reports if there is any 
- *       missing data in the cycle times. 
+ * @param in: fileData, name
+ *
+ * @note New devices have no cycle time and one unit until their own
+ *       config lines say otherwise.
  */
-void readConfigData( configData &fileData, char fileName[], bool &readFlag )
+static int registerDevice( configData &fileData, const string &name )
 {
-   ifstream fin;
-   const int logStreamSize = 2;  
-   string temp, tempTwo;
-   int index = 0; 
-   int indexTwo = 0;
+   cycleTime device;
+   string key = name;
+   unordered_map<string, int>::iterator found;
 
-   fin.open(fileName); 
-   readFlag = true; 
-   
-   if( fin.peek() == std::ifstream::traits_type::eof() )
+   key[0] = tolower( key[0] );
+   found = fileData.deviceIndex.find( key );
+
+   if( found != fileData.deviceIndex.end( ) )
    {
-      cout << fileName << " is either an empty config file or an invalid filename\n";
-      readFlag = false; 
+      return found->second;
    }
-   else 
-   {
-      while( !fin.eof( ) ) 
-      {
-         fin >> temp; 
-         if( ( temp.compare("Start") == 0 ) || ( temp.compare("End") == 0 ) )
-         {
-            fin.ignore( 1000, '\n' ); 
-         }
-         else if( temp.compare("Log:") == 0 )
-         {
-            while( indexTwo < logStreamSize )
-            {
-               fin >> temp; 
-               indexTwo++;
-            }
-            fin >> fileData.logData.logCriteria; 
-            indexTwo = 0; 
-         }
-         else if( temp.compare("Log") == 0 )
-         {
-            fin.ignore( 1000, ':' );
-            fin >> fileData.logData.logFilePath; 
-         }
-         else if( temp.compare("Version/Phase:") == 0 )
-         {
-            fin >> fileData.versionNum;
-         }
-         else if( temp.compare("File") == 0 ) 
-         {
-            fin.ignore( 1000, ':' );
-            fin >> fileData.filePath; 
-         }
-         else
-         {
-            tempTwo = temp; 
-            fin >> temp; 
-
-            if( tempTwo.compare("System") == 0 && temp.compare("memory") == 0 )
-            {
-            	fin.ignore( 1000, ':' );
-               fin >> fileData.systemMemorySize;
-            }
-            else if( tempTwo.compare("Memory") == 0 && temp.compare("block") == 0 )
-            {
-            	fin.ignore( 1000, ':' );
-               fin >> fileData.blockMemorySize;
-            }
-            else if( (tempTwo.compare("Printer") == 0) && (index > 7) )
-            {
-               fin >> fileData.printerQuantity;
-            }
-            else if( (tempTwo.compare("Hard") == 0) && (index > 7) )
-            {
-            	fin.ignore( 1000, ':' );
-               fin >> fileData.hardDriveQuantity;
-            }
-            else 
-            {
-            	fileData.cycleData[index].componentName = tempTwo;
 
-            	if( temp.compare("cycle") != 0 && temp.compare("display") != 0 ) 
-            	{
-               	fileData.cycleData[index].componentName = fileData.cycleData[index].componentName + " " + temp;
-            	}
+   device.componentName = name;
+   device.time = 0;
+   device.quantity = 1;
+   fileData.cycleData.push_back( device );
+   fileData.deviceIndex[key] = fileData.cycleData.size( ) - 1;
 
-            	fin.ignore( 1000, ':' );
+   return fileData.cycleData.size( ) - 1;
+}
 
-            	if( fin.peek() == '\n' )
-            	{
-               	cout << "You're missing one or more cycle time in the config file!\n";
-               	readFlag = false;
-               	fin.ignore( 1000, char_traits<char>::eof() );
-            	}
-            	else
-               	fin >> fileData.cycleData[index].time;
+/**
+ * @brief endsWith function.
+ *
+ * @details checks a config key for a suffix and cuts it off.
+ *
+ * @param in: key, suffix
+ *
+ * @param out: name (the key without the suffix)
+ *
+ * @note N/A.
+ */
+static bool endsWith( const string &key, const char suffix[], string &name )
+{
+   size_t length = strlen( suffix );
 
-            	index++; 
-            }
-         }
-         
-      }
+   if( ( key.size( ) <= length ) || ( key.compare( key.size( ) - length, length, suffix ) != 0 ) )
+   {
+      return false;
    }
-   
-   fin.close( ); 
+
+   name = key.substr( 0, key.size( ) - length );
+   return true;
 }
 
 /**
- * @brief readMetaData function
+ * @brief applyConfigEntry function.
  *
- * @details reads in meta-data from the meta-data file regarding to processes
- *          and cycle numbers.
- *          
- * @param in: metaDataStream (vector data structure), filePath
+ * @details reads one "key: value" line of a config into the config data.
+ *
+ * @param in: fileData, line, readFlag
  *
- * @note Parse the input stream in the file base on white space 
- *       characters and special characters. Reject these characters 
- *       they are not being used as special delimiters. The algorithm 
- *       checks for incorrect/missing data in its inputs. In addition,
- *       the algorithm checks for typos in the file.
+ * @note The key, without any unit in parentheses, is looked up in a hash
+ *       table built from CONFIG_KEYS. Keys ending in "cycle time" or
+ *       "display time" give the cycle time of a device and keys ending in
+ *       "quantity" its number of units; devices go into the registry in
+ *       the order they first appear, and there may be any number of them.
+ *       Unknown keys, unknown scheduling, memory allocation and page
+ *       replacement codes, missing cycle times and quantities below one
+ *       are reported and clear readFlag. Not thread safe: the key table is built on first use.
  */
-void readMetaData( vector<metaData> &metaDataStream, configData &fileData, char filePath[] )
-{
-   ifstream fin; 
-   metaData temp; 
-   char tempChar = '\0';
-   char tempCharTwo = '\0';
-   int tempNum = 0; 
-   int tempNumTwo = 0; 
-   bool flag = false;
-   char tempStr[30]; 
+static void applyConfigEntry( configData &fileData, const string &line, bool &readFlag )
+{
+   static unordered_map<string, int> keys;
+   unordered_map<string, int>::iterator found;
+   istringstream values;
+   string key, value, name, word;
+   size_t colon = 0;
+   size_t unit = 0;
    int index = 0;
-   int indexTwo = 0;
-   int length = 0;
+   int device = 0;
 
-   fin.open( filePath ); 
-   
-   if( fin.peek() == std::ifstream::traits_type::eof() )
+   if( keys.empty( ) )
    {
-      cout << filePath << " is either an empty metadata file or an invalid filename\n"; 
+      for( index = 0; index < (int) ( sizeof( CONFIG_KEYS ) / sizeof( CONFIG_KEYS[0] ) ); index++ )
+      {
+         keys[CONFIG_KEYS[index].key] = CONFIG_KEYS[index].field;
+      }
    }
-   else
+
+   colon = line.find( ':' );
+   key = line.substr( 0, colon );
+   value = ( colon == string::npos ) ? "" : line.substr( colon + 1 );
+   unit = key.find( '(' );
+
+   if( unit != string::npos )
+   {
+      key.erase( unit );
+   }
+
+   key.erase( key.find_last_not_of( " \t" ) + 1 );
+   values.str( value );
+   found = keys.find( key );
+
+   if( ( colon == string::npos ) || key.empty( ) )
+   {
+      cout << line << " is not a known config entry!\n";
+      readFlag = false;
+   }
+   else if( found != keys.end( ) )
    {
-      fin.ignore( 1000, '\n' ); 
-      
-      while( !fin.eof( ) ) 
+      switch( found->second )
       {
-         temp.code = fin.get( ); 
-         while( temp.code == '\n' )
-            temp.code = fin.get( );
+         case KEY_VERSION:
+            values >> fileData.versionNum;
+            break;
 
-         while( temp.code == ' ' )
-            temp.code = fin.get( );
-         
-         if( temp.code == 'E' )
-         {
-            fin.ignore( 1000, char_traits<char>::eof() ); 
-         }
-         else if( ( temp.code == 'S' ) ||
-                  ( temp.code == 'A' ) ||
-                  ( temp.code == 'M' ) ||
-                  ( temp.code == 'P' ) ||
-                  ( temp.code == 'I' ) ||
-                  ( temp.code == 'O' ) )
-         {
-            fin.ignore( 1000, '(' ); 
-            fin.getline( temp.description, 1000, ')' );
-            
-            if( ( temp.code == 'S' ) || ( temp.code == 'A' ) )
-            {
-               if( ( strcmp("start", temp.description) == 0 ) ||
-                   ( strcmp("end", temp.description) == 0 ) )
-               {
-                  flag = true; 
-               } 
-               else 
-               {
-                  flag = false; 
-                  fin.ignore( 1000, char_traits<char>::eof() );
-                  cout << "Sorry, either you made a typo or you forgot to enter the description\n"; 
-               }
-            } 
-            else if( temp.code == 'P' )
+         case KEY_FILE_PATH:
+            values >> fileData.filePath;
+            break;
+
+         case KEY_LOG:
+            while( values >> word )
             {
-               if( strcmp("run", temp.description) == 0 )
-               {
-                  flag = true; 
-               } 
-               else 
-               {
-                  flag = false; 
-                  fin.ignore( 1000, char_traits<char>::eof() );
-                  cout << "Sorry, either you made a typo or you forgot to enter the description\n";  
-               }
+               fileData.logData.logCriteria = word;
             }
-            else if( temp.code == 'M' )
+            break;
+
+         case KEY_LOG_PATH:
+            values >> word;
+            fileData.logData.logFilePath = word;
+            break;
+
+         case KEY_SYSTEM_MEMORY:
+            values >> fileData.systemMemorySize;
+            break;
+
+         case KEY_BLOCK_SIZE:
+            values >> fileData.blockMemorySize;
+            break;
+
+         case KEY_SCHEDULING:
+            values >> fileData.schedulingCode;
+
+            if( findPolicy( fileData.schedulingCode ) < 0 )
             {
-               if( ( strcmp("allocate", temp.description) == 0 ) ||
-                   ( strcmp("block", temp.description) == 0 ) )
-               {
-                  flag = true; 
-               } 
-               else 
-               {
-                  flag = false; 
-                  fin.ignore( 1000, char_traits<char>::eof() );
-                  cout << "Sorry, either you made a typo or you forgot to enter the description\n"; 
-               }
+               cout << fileData.schedulingCode << " is not a known CPU scheduling code!\n";
+               readFlag = false;
             }
-            else if( ( temp.code == 'I' ) || ( temp.code == 'O' ) )
-            {
-               flag = false; 
+            break;
 
-               for( indexTwo = 0; indexTwo < 8; indexTwo++ )
-               {
-                  length = strlen( temp.description ); 
+         case KEY_MEMORY_POLICY:
+            values >> fileData.memoryCode;
 
-                  if( fileData.cycleData[indexTwo].componentName.compare(1, length, temp.description, 1, length) == 0 )
-                  {
-                     flag = true;   
-                  }
-               }
- 
-               if( flag == false )
-               {
-                  fin.ignore( 1000, char_traits<char>::eof() );
-                  cout << "Sorry, either you made a typo or you forgot to enter the description\n";
-               }
+            if( findMemoryPolicy( fileData.memoryCode ) < 0 )
+            {
+               cout << fileData.memoryCode << " is not a known memory allocation code!\n";
+               readFlag = false;
             }
-            
-            if( flag == true )
+            break;
+
+         case KEY_PAGING:
+            values >> fileData.pagingCode;
+
+            if( findReplacementPolicy( fileData.pagingCode ) < 0 )
             {
-               tempChar = fin.get( );
-
-               while( tempChar == ' ' )
-                  tempChar = fin.get( );
-
-               if( tempChar == '-' )
-               {
-                  cout << "Invalid negative cycle values in meta-data file.\n";
-                  fin.ignore( 1000, char_traits<char>::eof() );
-               }
-               else if( ( tempChar != '0' ) && 
-                   ( tempChar != '1' ) && 
-                   ( tempChar != '2' ) &&
-                   ( tempChar != '3' ) &&
-                   ( tempChar != '4' ) &&
-                   ( tempChar != '5' ) &&
-                   ( tempChar != '6' ) && 
-                   ( tempChar != '7' ) && 
-                   ( tempChar != '8' ) && 
-                   ( tempChar != '9' ) )
-               {
-                  cout << "You're missing a cycle value in the meta-data file.\n";
-                  fin.ignore( 1000, char_traits<char>::eof() );
-               }
-               else
-               {
-                  tempNum = tempChar - '0'; 
-                  tempCharTwo = fin.get( ); 
-                  temp.cycles = tempNum;
-                  while( ( tempCharTwo == '0' ) || 
-                      ( tempCharTwo == '1' ) || 
-                      ( tempCharTwo == '2' ) ||
-                      ( tempCharTwo == '3' ) ||
-                      ( tempCharTwo == '4' ) ||
-                      ( tempCharTwo == '5' ) ||
-                      ( tempCharTwo == '6' ) || 
-                      ( tempCharTwo == '7' ) || 
-                      ( tempCharTwo == '8' ) || 
-                      ( tempCharTwo == '9' ) )
-                  {
-                     tempNum = tempNum * 10; 
-                     tempNumTwo = tempCharTwo - '0'; 
-                     temp.cycles = tempNum + tempNumTwo;
-                     tempCharTwo = fin.get( );
-                  }
-
-                  metaDataStream.push_back( temp );
-
-                  tempChar = fin.peek( ); 
-            
-                  if( tempChar == ' ' )
-                  {
-                     fin.ignore( 1000, ' ' );
-                     tempChar = fin.peek( ); 
-                     if( tempChar == '\n' )
-                        fin.ignore( 1000, '\n' ); 
-                  }
-                  index++;
-               } 
+               cout << fileData.pagingCode << " is not a known page replacement code!\n";
+               readFlag = false;
             }
-         }
-         else
-         {
-            cout << "In the metadata file, you either did not enter a metadata code or the code is invalid.\n"; 
-            fin.ignore( 1000, char_traits<char>::eof() );  
-         }
+            break;
+
+         case KEY_TLB:
+            values >> fileData.tlbEntries;
+            break;
+
+         case KEY_QUANTUM:
+            values >> fileData.quantumNumber;
+            break;
+
+         case KEY_CORES:
+            values >> fileData.processorCores;
+            break;
+
+         case KEY_SWITCH_TIME:
+            values >> fileData.contextSwitchTime;
+            break;
       }
    }
-   fin.close( ); 
+   else if( endsWith( key, " cycle time", name ) || endsWith( key, " display time", name ) )
+   {
+      device = registerDevice( fileData, name );
+
+      if( !( values >> fileData.cycleData[device].time ) )
+      {
+         cout << "You're missing one or more cycle time in the config file!\n";
+         readFlag = false;
+      }
+   }
+   else if( endsWith( key, " quantity", name ) )
+   {
+      device = registerDevice( fileData, name );
 
+      if( !( values >> fileData.cycleData[device].quantity ) || ( fileData.cycleData[device].quantity < 1 ) )
+      {
+         cout << key << " must be at least 1!\n";
+         readFlag = false;
+      }
+   }
+   else
+   {
+      cout << key << " is not a known config entry!\n";
+      readFlag = false;
+   }
 }
 
 /**
- * @brief findTime function.
+ * @brief checkConfigData function.
  *
- * @details find the time in ms between two intervals. 
- *          
- * @param in: t1, t2
+ * @details checks the entries of a config that only make sense together.
  *
- * @note N/A.  
+ * @param in: fileData, readFlag
+ *
+ * @note A page replacement code turns on demand paging, which takes the
+ *       place of the memory manager and needs memory for at least one
+ *       page.
  */
-double findTime( struct timeval t1, struct timeval t2 )
+static void checkConfigData( configData &fileData, bool &readFlag )
 {
-   double elapsedTime = ( t2.tv_sec - t1.tv_sec ) * 1000.0;
-   elapsedTime += ( t2.tv_usec - t1.tv_usec ) / 1000.0;
-   elapsedTime = elapsedTime / 1000.0;  
+   if( readFlag && ( findReplacementPolicy( fileData.pagingCode ) != NO_PAGING ) )
+   {
+      if( findMemoryPolicy( fileData.memoryCode ) != MODULO_FIT )
+      {
+         cout << "Paging cannot be used with the " << fileData.memoryCode << " memory allocation code!\n";
+         readFlag = false;
+      }
+      else if( ( fileData.blockMemorySize <= 0 ) || ( fileData.systemMemorySize < fileData.blockMemorySize ) )
+      {
+         cout << "Paging needs room for at least one memory block!\n";
+         readFlag = false;
+      }
+   }
 }
 
 /**
- * @brief wait function.
+ * @brief readConfigData function.
  *
- * @details determine the time in ms between two intervals. 
+ * @details reads in config data from the config file. 
  *          
- * @param in: t1, t2, cycleTime
+ * @param in: fileData, fileName, readFlag
  *
- * @note N/A.  
+ * @note Accepts file name from the parameter. Each line is split at its
+ *       colon into a key and a value and read by applyConfigEntry. Checks
+ *       for empty file and incorrect filenames. In addition, the function
+ *       reports unknown keys and any missing data in the cycle times. The
+ *       CPU scheduling code must be one the scheduler knows; without one
+ *       the processes run FIFO. Likewise the memory allocation code must
+ *       be one the memory manager knows; without one memory is handed out
+ *       by the original modulo locator. checkConfigData then checks the
+ *       paging entries. 
  */
-void wait( struct timeval t1, struct timeval t2, double cycleTime1 )
+void readConfigData( configData &fileData, char fileName[], bool &readFlag )
 {
-	double elapsedTime = findTime( t1, t2 ); 
- 
-   cycleTime1 = elapsedTime + cycleTime1;
+   ifstream fin;
+   string line;
+
+   fin.open(fileName); 
+   readFlag = true; 
    
-   while( elapsedTime < cycleTime1 )
+   if( fin.peek() == std::ifstream::traits_type::eof() )
+   {
+      cout << fileName << " is either an empty config file or an invalid filename\n";
+      readFlag = false; 
+   }
+
+   while( readFlag && getline( fin, line ) )
    {
-   	gettimeofday(&t2, NULL);
-      elapsedTime = findTime( t1, t2 ); 
+      if( !line.empty( ) && ( line[line.size( ) - 1] == '\r' ) )
+      {
+         line.erase( line.size( ) - 1 );
+      }
+
+      if( ( line.find_first_not_of( " \t" ) == string::npos ) ||
+          ( line.compare( 0, 5, "Start" ) == 0 ) || ( line.compare( 0, 3, "End" ) == 0 ) )
+      {
+         continue;
+      }
+
+      applyConfigEntry( fileData, line, readFlag );
    }
+
+   checkConfigData( fileData, readFlag );
+   
+   fin.close( ); 
 }
 
 /**
- * @brief pWait function.
+ * @brief readMetaData function
  *
- * @details calculate and wait for the elipsed time in ms between two intervals. 
+ * @details reads in meta-data from the meta-data file regarding to processes
+ *          and cycle numbers.
  *          
- * @param in: threadArg
+ * @param in: metaDataStream (vector data structure), filePath, writeCache
  *
- * @note N/A.  
+ * @note Maps the file and tokenizes it in one pass over the mapped bytes
+ *       with parseMetaOp, which checks for incorrect/missing data and for
+ *       typos in the file and compiles each operation into an opRecord.
+ *       Reading stops at the first error as before. With writeCache set, a
+ *       file that parses without error is saved as its .mdb cache. Returns
+ *       false if the file cannot be read or does not parse to its end.
  */
-void *pWait(void *threadArg)
+bool readMetaData( vector<opRecord> &metaDataStream, configData &fileData, const char filePath[], bool writeCache )
 {
-	
-	sem_wait(&mutex); 
-   struct threadData *IOData = (struct threadData *) threadArg;
-   
-   double elapsedTime = findTime( IOData->t1, IOData->t2 ); 
+   mappedFile file;
+   metaCacheWriter writer;
+   const char *next = NULL;
+   const char *end = NULL;
+   opRecord temp; 
+   int cycles = 0;
+   int status = META_OP;
+
+   if( mapFile( file, filePath ) == false )
+   {
+      cout << filePath << " is either an empty metadata file or an invalid filename\n"; 
+      return false;
+   }
 
-   IOData->cycleTime2 = IOData->cycleTime2 + elapsedTime;
-   
-   while( elapsedTime < IOData->cycleTime2 )
+   next = (const char *) memchr( file.data, '\n', file.size );
+   end = file.data + file.size;
+   next = ( next == NULL ) ? end : next + 1;
+
+   beginMetaCache( writer );
+   status = parseMetaOp( fileData, next, end, true, temp, cycles );
+
+   while( status == META_OP )
+   {
+      metaDataStream.push_back( temp );
+
+      if( writeCache == true )
+      {
+         addMetaCacheOp( writer, fileData, temp, cycles );
+      }
+
+      status = parseMetaOp( fileData, next, end, true, temp, cycles );
+   }
+
+   if( ( writeCache == true ) && ( status == META_END ) )
    {
-   	gettimeofday(&IOData->t2, NULL); 
-      elapsedTime = findTime( IOData->t1, IOData->t2 );
+      saveMetaCache( writer, filePath, file );
    }
-	sem_post(&mutex);
+
+   unmapFile( file );
+
+   return status == META_END;
 }
 
 /**
- * @brief printMetrics function. 
+ * @brief readBatchManifest function.
  *
- * @details output all the meta-data time and thread metrics to the monitor. Utilize
- *          mutex to handle processes and semaphore to handle threads.
- *          
- * @param in: metaDataStream, fileData, processObj
+ * @details reads the jobs of a batch manifest.
+ *
+ * @param in: manifest, outDir
  *
- * @note None
+ * @param out: batch
+ *
+ * @note One job per line: a config file and, optionally, a meta-data file
+ *       that replaces the config's File Path. Blank lines and lines that
+ *       start with '#' are skipped. Job N logs to outDir/jobN.log. Returns
+ *       false if the manifest cannot be read or a line has more than two
+ *       fields.
  */
-void printMetrics( vector<metaData> &metaDataStream, configData &fileData, PCB &processObj )
+static bool readBatchManifest( batchRun &batch, const char manifest[], const char outDir[] )
 {
-   int index = 0;
-   int indexTwo = 0;
-   int length = 0;
-   int processID = 0; 
-   int threadSize = 1;
-   unsigned int memoryNum = 0;
-   struct timeval t1, t2; 
-   double elapsedTime;
-   double cycles; 
-   pthread_t OSThreads;
-   pthread_attr_t attr;
-   void *status; 
-   struct threadData td; 
-   int rc; 
-   int indexThree = 0;
-   int indexFour = 0;
-   int indexFive = 0;
-
-   pthread_attr_init(&attr);
-   pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-   gettimeofday(&t1, NULL);
-  	gettimeofday(&t2, NULL); 
-   elapsedTime = findTime( t1, t2 ); 
-   
-   cout << setprecision(6) << elapsedTime << " - " << "Simulator program starting\n";  
+   ifstream fin( manifest );
+   string line, extra;
+   ostringstream name;
+   batchJob job;
+   int lineNumber = 0;
 
-   for( index = 0; index < metaDataStream.size( ); index++ ) 
+   if( !fin.is_open( ) )
    {
+      cout << manifest << " is not a batch manifest that can be read\n";
+      return false;
+   }
 
-		
-		int pthread_mutex_lock(pthread_mutex_t *mutex);
+   while( getline( fin, line ) )
+   {
+      istringstream fields( line );
 
+      lineNumber++;
+      job = batchJob( );
 
-      if( metaDataStream[index].code == 'P' )
+      if( !( fields >> job.configFile ) || ( job.configFile[0] == '#' ) )
       {
-         for( indexTwo = 0; indexTwo < 8; indexTwo++ )
-         {
-            if( fileData.cycleData[indexTwo].componentName.compare("Processor") == 0 )
-            {
-               processObj.processState = WAITING; 
-               cycles = ( metaDataStream[index].cycles * fileData.cycleData[indexTwo].time ) / 1000.0; 
-  					gettimeofday(&t2, NULL);  
-               elapsedTime = findTime( t1, t2 ); 
-               cout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": start processing action"<< endl;
-               wait( t1, t2, cycles );
-               gettimeofday(&t2, NULL); 
-               elapsedTime = findTime( t1, t2 ); 
-               cout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": end processing action"<< endl;
-            }
-         }
+         continue;
       }
-      else if( metaDataStream[index].code == 'A' )
+
+      if( ( fields >> job.metaFile ) && ( fields >> extra ) )
       {
-         if( strcmp( metaDataStream[index].description, "start" ) == 0 )
-         {
-            processObj.processState = START; 
-            processID++;
-            gettimeofday(&t2, NULL); 
-            elapsedTime = findTime( t1, t2 ); 
-            cout << setprecision(6) << elapsedTime << " - " << "OS: preparing process " << processID << endl;
-            gettimeofday(&t2, NULL); 
-            elapsedTime = findTime( t1, t2 ); 
-            cout << setprecision(6) << elapsedTime << " - " << "OS: starting process " << processID << endl;
-         }
-         else if( strcmp( metaDataStream[index].description, "end" ) == 0 )
-         {
-            processObj.processState = EXIT; 
-            gettimeofday(&t2, NULL); 
-            elapsedTime = findTime( t1, t2 ); 
-            cout << setprecision(6) << elapsedTime << " - " << "OS: removing process " << processID << endl;
-         }
+         cout << "Line " << lineNumber << " of " << manifest << " has more than a config and a meta-data file\n";
+         return false;
       }
-      else if( metaDataStream[index].code == 'M' )
+
+      name.str( "" );
+      name << outDir << "/job" << batch.jobs.size( ) + 1 << ".log";
+      job.outFile = name.str( );
+      job.workload = -1;
+      job.status = "config error";
+      batch.jobs.push_back( job );
+   }
+
+   return true;
+}
+
+/**
+ * @brief addBatchWorkload function.
+ *
+ * @details finds the shared meta-data file of a batch job, mapping it the
+ *          first time a job names it.
+ *
+ * @param in: batch, workloads (path to index), job, useCache
+ *
+ * @note The file is mapped from its .mdb cache, written first if it is not
+ *       current; one that has no cache, or every one under --no-cache, is
+ *       parsed by each job that runs it. Standard input and FIFOs cannot
+ *       be shared, so jobs on them fail, and it returns false. A job whose
+ *       file is missing or does not parse keeps the status "meta-data
+ *       error"; any other is ready to run.
+ */
+static bool addBatchWorkload( batchRun &batch, unordered_map<string, int> &workloads, batchJob &job, bool useCache )
+{
+   unordered_map<string, int>::iterator found;
+   vector<opRecord> parsed;
+   batchWorkload workload;
+   struct stat info;
+
+   job.status = "meta-data error";
+
+   if( ( job.metaFile.compare( "-" ) != 0 ) && ( stat( job.metaFile.c_str( ), &info ) != 0 ) )
+   {
+      cout << job.metaFile << " is either an empty metadata file or an invalid filename\n";
+      return true;
+   }
+
+   if( ( job.metaFile.compare( "-" ) == 0 ) || !S_ISREG( info.st_mode ) )
+   {
+      cout << job.metaFile << " is not a regular file and cannot be shared between runs\n";
+      return false;
+   }
+
+   found = workloads.find( job.metaFile );
+
+   if( found == workloads.end( ) )
+   {
+      workload.path = job.metaFile;
+      workload.cache = metaCache( );
+      workload.cached = false;
+
+      if( useCache == true )
       {
-         for( indexTwo = 0; indexTwo < 8; indexTwo++ )
+         workload.cached = loadMetaCache( workload.cache, job.fileData, job.metaFile.c_str( ) );
+
+         if( workload.cached == false )
          {
-            if( fileData.cycleData[indexTwo].componentName.compare("Memory") == 0 )
+            if( readMetaData( parsed, job.fileData, job.metaFile.c_str( ), true ) == false )
             {
-               if( strcmp( metaDataStream[index].description, "allocate" ) == 0 )
-         		{
-                  processObj.processState = RUNNING;;
-            		cycles = ( metaDataStream[index].cycles * fileData.cycleData[indexTwo].time ) / 1000.0; 
-  					   gettimeofday(&t2, NULL); 
-                  wait( t1, t2, cycles ); 
-                  elapsedTime = findTime( t1, t2 ); 
-               	cout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": allocating memory"<< endl;
-               	gettimeofday(&t2, NULL); 
-                  elapsedTime = findTime( t1, t2 ); 
-               	cout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": memory allocated at ";
-                  cout << "0x" << setfill('0');
-                  cout << setw(8) << hex << memoryNum << endl;
-                  memoryNum = allocateMemory( memoryNum, fileData.blockMemorySize, fileData.systemMemorySize);
-         		}
-               else if( strcmp( metaDataStream[index].description, "block" ) == 0 )
-         		{
-                  processObj.processState = READY;
-            		cycles = ( metaDataStream[index].cycles * fileData.cycleData[indexTwo].time ) / 1000.0; 
-  					   gettimeofday(&t2, NULL); 
-                  wait( t1, t2, cycles );  
-                  elapsedTime = findTime( t1, t2 );  
-               	cout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": start memory blocking"<< endl;
-               	gettimeofday(&t2, NULL); 
-                  elapsedTime = findTime( t1, t2 ); 
-               	cout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": end memory blocking"<< endl;
-         		}
+               return true;
             }
+
+            workload.cached = loadMetaCache( workload.cache, job.fileData, job.metaFile.c_str( ) );
          }
       }
-      else if( ( metaDataStream[index].code == 'I' ) || ( metaDataStream[index].code == 'O' ) )
+
+      found = workloads.insert( make_pair( job.metaFile, (int) batch.workloads.size( ) ) ).first;
+      batch.workloads.push_back( workload );
+   }
+
+   job.workload = found->second;
+   job.status = "ok";
+
+   return true;
+}
+
+/**
+ * @brief prepareBatch function.
+ *
+ * @details reads the configs of a batch and maps its meta-data files.
+ *
+ * @param in: batch, useCache
+ *
+ * @note Runs before the worker threads start: the config reader is not
+ *       thread safe, and each config and meta-data file is read only once
+ *       however many jobs name it. Every job logs to its own file whatever
+ *       its config asks for.
+ */
+static void prepareBatch( batchRun &batch, bool useCache )
+{
+   unordered_map<string, int> configs;
+   unordered_map<string, int> workloads;
+   unordered_map<string, int>::iterator found;
+   string path;
+   bool readFlag = true;
+   int index = 0;
+
+   for( index = 0; index < (int) batch.jobs.size( ); index++ )
+   {
+      batchJob &job = batch.jobs[index];
+
+      found = configs.find( job.configFile );
+
+      if( found != configs.end( ) )
+      {
+         job.fileData = batch.jobs[found->second].fileData;
+         readFlag = ( batch.jobs[found->second].status.compare( "config error" ) != 0 );
+      }
+      else
       {
-         for( indexTwo = 0; indexTwo < 8; indexTwo++ )
-         {
-            length = strlen( metaDataStream[index].description ); 
+         path = job.configFile;
+         job.fileData = configData( );
+         readFlag = true;
+         readConfigData( job.fileData, &path[0], readFlag );
+         configs[job.configFile] = index;
+      }
 
-            if( fileData.cycleData[indexTwo].componentName.compare(1, length, metaDataStream[index].description, 1, length) == 0 )
-            {
-               processObj.processState = WAITING;
-            	cycles = ( metaDataStream[index].cycles * fileData.cycleData[indexTwo].time ) / 1000.0; 
-  					gettimeofday(&t2, NULL); 
-               elapsedTime = findTime( t1, t2 ); 
-               cout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": start ";
-               cout << metaDataStream[index].description; 
-               if( metaDataStream[index].code == 'I' )
-               {
-               	cout << " input\n"; 
-               }
-               if( metaDataStream[index].code == 'O' )
-               {
-               	cout << " output\n"; 
-               } 
-               td.t1 = t1; 
-               td.t2 = t2; 
-               td.cycleTime2 = cycles; 
-
-					
-					sem_init(&mutex, 0, 1);
-
-               rc = pthread_create(&OSThreads, &attr, pWait, (void*) &td);
-					if(rc)
- 					{
-						cout << "Error: cannot create thread " << rc << endl; 
- 						exit(-1); 
-					}
-               processObj.processState = READY;
-               rc = pthread_join(OSThreads, &status);
-      
-					sem_destroy(&mutex);
-
-      			if( rc )
-      			{
-         			cout << "Error: can't join " << rc << endl;
-         			exit(-1);
-      			}
-
-               gettimeofday(&t2, NULL);
-               elapsedTime = findTime( t1, t2 ); 
-               cout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": end ";
-               cout << metaDataStream[index].description; 
-
-               if( metaDataStream[index].code == 'I' )
-               {
-               	cout << " input"; 
-               }
-               if( metaDataStream[index].code == 'O' )
-               {
-               	cout << " output"; 
-               }
-               if( strcmp( metaDataStream[index].description, "hard drive" ) == 0 ) 
-               {
-                  cout << " on HDD " << indexFour;
-                  indexFour++;
-						if( fileData.hardDriveQuantity != 0 )
-                  	indexFour = indexFour % fileData.hardDriveQuantity;
-               }
-               if( strcmp( metaDataStream[index].description, "printer" ) == 0 ) 
-               {
-                  cout << " on PRNTR " << indexFive;
-                  indexFive++;
-                  if( fileData.printerQuantity != 0 )
-                  	indexFive = indexFive % fileData.printerQuantity;
-               }
-               cout << endl;
-            }
-         }
+      if( readFlag == false )
+      {
+         continue;
+      }
+
+      job.fileData.logData.logCriteria = "File";
+      job.fileData.logData.logFilePath = job.outFile;
+
+      if( job.metaFile.empty( ) )
+      {
+         job.metaFile = job.fileData.filePath;
       }
-		int pthread_mutex_unlock(pthread_mutex_t *mutex);
+
+      addBatchWorkload( batch, workloads, job, useCache );
    }
 }
 
 /**
- * @brief outputToFileMetrics function. 
+ * @brief runBatchJob function.
  *
- * @details output all the meta-data time and thread metrics to the monitor. Utilize
- *          mutex to handle processes and semaphore to handle threads.  
- *          
- * @param in: metaDataStream, fileData, processObj
+ * @details runs one job of a batch on the calling thread.
+ *
+ * @param in: batch, job
+ *
+ * @note Does what main does for a single config, with the job's own
+ *       clock, device pool and log. A job whose config lacks an I/O device
+ *       its shared cache names parses the text, for the typo message; if
+ *       that fails, the job does not run and its status is "meta-data
+ *       error".
+ */
+static void runBatchJob( batchRun &batch, batchJob &job )
+{
+   long long started = readMonotonic( );
+   vector<opRecord> metaDataStream;
+   metaCache cache = metaCache( );
+   logSink sink = logSink( );
+   simClock clock;
+   devicePool pool;
+   metaFeed feed;
+
+   if( batch.workloads[job.workload].cached &&
+       ( shareMetaCache( cache, batch.workloads[job.workload].cache, job.fileData ) == true ) )
+   {
+      openCachedFeed( feed, cache, batch.residentLimit );
+   }
+   else
+   {
+      if( readMetaData( metaDataStream, job.fileData, job.metaFile.c_str( ), false ) == false )
+      {
+         unloadMetaCache( cache );
+         job.status = "meta-data error";
+         job.wallSeconds = ( readMonotonic( ) - started ) / 1e9;
+         return;
+      }
+
+      openBatchFeed( feed, metaDataStream, batch.residentLimit );
+   }
+
+   initClock( clock, batch.virtualTime, batch.spinTime );
+   startDevicePool( pool, clock, job.fileData );
+
+   if( openLogSink( sink, job.fileData, NULL ) == true )
+   {
+      runSimulation( feed, job.fileData, clock, sink, pool, job.result );
+   }
+   else
+   {
+      job.status = "log error";
+   }
+
+   closeLogSink( sink );
+   closeFeed( feed );
+   unloadMetaCache( cache );
+   stopDevicePool( pool );
+   destroyClock( clock );
+
+   job.wallSeconds = ( readMonotonic( ) - started ) / 1e9;
+}
+
+/**
+ * @brief batchWorker function.
+ *
+ * @details worker thread of a batch: runs jobs until none are left.
+ *
+ * @param in: arg (the batchRun)
  *
- * @note None
+ * @note Jobs are taken in manifest order, so long ones listed first start
+ *       first.
  */
-void outputToFileMetrics( vector<metaData> &metaDataStream, configData &fileData, PCB &processObj )
+static void *batchWorker( void *arg )
 {
+   batchRun &batch = *(batchRun *) arg;
+   int index = batch.nextJob.fetch_add( 1 );
+
+   while( index < (int) batch.jobs.size( ) )
+   {
+      if( batch.jobs[index].status.compare( "ok" ) == 0 )
+      {
+         runBatchJob( batch, batch.jobs[index] );
+      }
+
+      index = batch.nextJob.fetch_add( 1 );
+   }
+
+   return NULL;
+}
+
+/**
+ * @brief csvField function.
+ *
+ * @details quotes a text field of the batch summary if it needs it.
+ *
+ * @param in: text
+ *
+ * @note N/A.
+ */
+static string csvField( const string &text )
+{
+   string quoted = "\"";
    int index = 0;
-   int indexTwo = 0;
-   int length = 0;
-   int processID = 0; 
-   int threadSize = 1;
-   unsigned int memoryNum = 00000000;
-   struct timeval t1, t2; 
-   double elapsedTime;
-   double cycles; 
-   pthread_t OSThreads;
-   pthread_attr_t attr;
-   void *status; 
-   struct threadData td; 
-   int rc; 
-   int indexThree = 0;
-   int indexFour = 0;
-   int indexFive = 0;
-   ofstream fout; 
-
-   fout.open( fileData.logData.logFilePath );
-   pthread_attr_init(&attr);
-   pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-   gettimeofday(&t1, NULL);
-  	gettimeofday(&t2, NULL); 
-   elapsedTime = findTime( t1, t2 ); 
-   
-   fout << setprecision(6) << elapsedTime << " - " << "Simulator program starting\n";  
 
-   for( index = 0; index < metaDataStream.size( ); index++ ) 
+   if( text.find_first_of( ",\"\n" ) == string::npos )
    {
-      int pthread_mutex_lock(pthread_mutex_t *mutex);
+      return text;
+   }
 
-      if( metaDataStream[index].code == 'P' )
+   for( index = 0; index < (int) text.size( ); index++ )
+   {
+      quoted += text[index];
+
+      if( text[index] == '"' )
       {
-         for( indexTwo = 0; indexTwo < 8; indexTwo++ )
-         {
-            if( fileData.cycleData[indexTwo].componentName.compare("Processor") == 0 )
-            {
-               processObj.processState = WAITING; 
-               cycles = ( metaDataStream[index].cycles * fileData.cycleData[indexTwo].time ) / 1000.0; 
-  					gettimeofday(&t2, NULL);  
-               elapsedTime = findTime( t1, t2 ); 
-               fout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": start processing action"<< endl;
-               wait( t1, t2, cycles );
-               gettimeofday(&t2, NULL); 
-               elapsedTime = findTime( t1, t2 ); 
-               fout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": end processing action"<< endl;
-            }
-         }
+         quoted += '"';
+      }
+   }
+
+   return quoted + "\"";
+}
+
+/**
+ * @brief cpuUtilization function.
+ *
+ * @details share of the makespan the cores were busy, over all cores.
+ *
+ * @param in: result
+ *
+ * @note As in the run summary.
+ */
+static double cpuUtilization( const simResult &result )
+{
+   int cores = result.coreBusy.size( );
+
+   if( ( result.makespan <= 0 ) || ( cores == 0 ) )
+   {
+      return 0.0;
+   }
+
+   return (double) result.cpuBusy / result.makespan / cores;
+}
+
+/**
+ * @brief deviceUtilization function.
+ *
+ * @details share of the makespan the units of a device were busy, over
+ *          all its units.
+ *
+ * @param in: result, device, units
+ *
+ * @note As cpuUtilization does for the cores.
+ */
+static double deviceUtilization( const simResult &result, int device, int units )
+{
+   if( ( result.makespan <= 0 ) || ( units <= 0 ) )
+   {
+      return 0.0;
+   }
+
+   return (double) result.deviceBusy[device] / result.makespan / units;
+}
+
+/**
+ * @brief deviceColumn function.
+ *
+ * @details the sweep's column name for a device: its name in lower case
+ *          with spaces as underscores, such as "hard_drive".
+ *
+ * @param in: name
+ *
+ * @note N/A.
+ */
+static string deviceColumn( const string &name )
+{
+   string column = name;
+   int index = 0;
+
+   for( index = 0; index < (int) column.size( ); index++ )
+   {
+      column[index] = ( column[index] == ' ' ) ? '_' : tolower( column[index] );
+   }
+
+   return column;
+}
+
+/**
+ * @brief writeBatchSummary function.
+ *
+ * @details writes one CSV row per job of a batch.
+ *
+ * @param in: batch, path
+ *
+ * @note Times are in seconds and means are per process, as in the run
+ *       summary. Jobs that did not run have only their files and status.
+ *       Returns false if the file cannot be written.
+ */
+static bool writeBatchSummary( batchRun &batch, const string &path )
+{
+   ofstream fout( path.c_str( ) );
+   int index = 0;
+   int processes = 0;
+
+   if( !fout.is_open( ) )
+   {
+      cout << "Cannot open batch summary " << path << endl;
+      return false;
+   }
+
+   fout << "job,config,meta_data,log,status,processes,makespan_sec,cpu_utilization,"
+        << "turnaround_mean_sec,turnaround_max_sec,waiting_mean_sec,waiting_max_sec,"
+        << "response_mean_sec,response_max_sec,context_switches,memory_failures,page_faults,wall_sec\n";
+   fout << fixed << setprecision(6);
+
+   for( index = 0; index < (int) batch.jobs.size( ); index++ )
+   {
+      batchJob &job = batch.jobs[index];
+      simResult &result = job.result;
+
+      fout << index + 1 << "," << csvField( job.configFile ) << "," << csvField( job.metaFile ) << ","
+           << csvField( job.outFile ) << "," << job.status;
+
+      if( job.status.compare( "ok" ) != 0 )
+      {
+         fout << ",,,,,,,,,,,,,\n";
+         continue;
+      }
+
+      processes = max( result.processCount, 1 );
+
+      fout << "," << result.processCount << "," << toSeconds( result.makespan ) << ","
+           << cpuUtilization( result ) << ","
+           << toSeconds( result.totalTurnaround ) / processes << "," << toSeconds( result.maxTurnaround ) << ","
+           << toSeconds( result.totalWaiting ) / processes << "," << toSeconds( result.maxWaiting ) << ","
+           << toSeconds( result.totalResponse ) / processes << "," << toSeconds( result.maxResponse ) << ","
+           << result.switchCount << "," << result.memory.failures << "," << result.paging.faults << ","
+           << job.wallSeconds << "\n";
+   }
+
+   fout.close( );
+
+   return !fout.fail( );
+}
+
+/**
+ * @brief runBatchJobs function.
+ *
+ * @details runs the ready jobs of a batch on a pool of worker threads and
+ *          releases its meta-data files.
+ *
+ * @param in: batch, workers
+ *
+ * @note workers defaults to the number of online cores when it is not
+ *       positive, and is never more than the jobs. Returns the number of
+ *       threads used.
+ */
+static int runBatchJobs( batchRun &batch, int workers )
+{
+   vector<pthread_t> threads;
+   int index = 0;
+
+   if( workers <= 0 )
+   {
+      workers = sysconf( _SC_NPROCESSORS_ONLN );
+   }
+   workers = max( min( workers, (int) batch.jobs.size( ) ), 1 );
+   threads.resize( workers );
+   batch.nextJob.store( 0 );
+
+   for( index = 0; index < workers; index++ )
+   {
+      pthread_create( &threads[index], NULL, batchWorker, &batch );
+   }
+
+   for( index = 0; index < workers; index++ )
+   {
+      pthread_join( threads[index], NULL );
+   }
+
+   for( index = 0; index < (int) batch.workloads.size( ); index++ )
+   {
+      unloadMetaCache( batch.workloads[index].cache );
+   }
+
+   return workers;
+}
+
+/**
+ * @brief runBatch function.
+ *
+ * @details runs every job of a manifest on a pool of worker threads.
+ *
+ * @param in: manifest, outDir, workers, useCache, virtualTime, spinTime,
+ *            residentLimit
+ *
+ * @note Each job's log is
+ *       outDir/jobN.log and one row per job goes to outDir/summary.csv,
+ *       with the status of jobs that failed. Returns false if the manifest
+ *       or the summary cannot be used.
+ */
+bool runBatch( const char manifest[], const char outDir[], int workers, bool useCache,
+               bool virtualTime, simTime spinTime, int residentLimit )
+{
+   batchRun batch;
+   long long started = readMonotonic( );
+   string summaryPath = string( outDir ) + "/summary.csv";
+   streamsize oldPrecision = cout.precision( );
+   int failed = 0;
+   int index = 0;
+
+   batch.virtualTime = virtualTime;
+   batch.spinTime = spinTime;
+   batch.residentLimit = residentLimit;
+
+   if( readBatchManifest( batch, manifest, outDir ) == false )
+   {
+      return false;
+   }
+
+   if( ( mkdir( outDir, 0755 ) != 0 ) && ( errno != EEXIST ) )
+   {
+      cout << "Cannot create batch output directory " << outDir << endl;
+      return false;
+   }
+
+   prepareBatch( batch, useCache );
+   workers = runBatchJobs( batch, workers );
+
+   for( index = 0; index < (int) batch.jobs.size( ); index++ )
+   {
+      if( batch.jobs[index].status.compare( "ok" ) != 0 )
+      {
+         failed++;
+      }
+   }
+
+   cout << "Batch: " << batch.jobs.size( ) << " jobs, " << failed << " failed, " << workers << " threads, "
+        << fixed << setprecision(3) << ( readMonotonic( ) - started ) / 1e9 << " sec" << endl;
+   cout.unsetf( ios::floatfield );
+   cout.precision( oldPrecision );
+
+   return writeBatchSummary( batch, summaryPath );
+}
+
+/**
+ * @brief parseSweep function.
+ *
+ * @details reads a --sweep parameter: KEY=LOW:HIGH[:STEP] or KEY=A,B,...
+ *
+ * @param in: text
+ *
+ * @param out: parameter
+ *
+ * @note KEY is a config key as it is written in a config file, without its
+ *       unit, such as "Hard drive cycle time" or "Printer quantity". A
+ *       range takes every STEP, 1 by default, from LOW up to HIGH; a list
+ *       may hold values of any kind, such as scheduling codes. Returns
+ *       false for anything else.
+ */
+static bool parseSweep( const char text[], sweepParameter &parameter )
+{
+   const char *equals = strchr( text, '=' );
+   long long low = 0;
+   long long high = 0;
+   long long step = 1;
+   long long value = 0;
+   char extra = '\0';
+   string values, item;
+   istringstream items;
+
+   if( ( equals == NULL ) || ( equals == text ) || ( equals[1] == '\0' ) )
+   {
+      return false;
+   }
+
+   parameter.key.assign( text, equals - text );
+   parameter.values.clear( );
+   values = equals + 1;
+
+   if( ( sscanf( values.c_str( ), "%lld:%lld%c", &low, &high, &extra ) == 2 ) ||
+       ( sscanf( values.c_str( ), "%lld:%lld:%lld%c", &low, &high, &step, &extra ) == 3 ) )
+   {
+      if( ( step <= 0 ) || ( high < low ) || ( ( high - low ) / step >= MAX_SWEEP_POINTS ) )
+      {
+         return false;
+      }
+
+      for( value = low; value <= high; value = value + step )
+      {
+         parameter.values.push_back( to_string( value ) );
+      }
+
+      return true;
+   }
+
+   items.str( values );
+
+   while( getline( items, item, ',' ) )
+   {
+      if( item.empty( ) )
+      {
+         return false;
+      }
+
+      parameter.values.push_back( item );
+   }
+
+   return !parameter.values.empty( );
+}
+
+/**
+ * @brief nextSweepPoint function.
+ *
+ * @details steps the value positions of a sweep to its next point.
+ *
+ * @param in: parameters, position
+ *
+ * @note The last parameter changes fastest. After the last point the
+ *       positions are back at the first.
+ */
+static void nextSweepPoint( const vector<sweepParameter> &parameters, vector<int> &position )
+{
+   int index = 0;
+
+   for( index = parameters.size( ) - 1; index >= 0; index-- )
+   {
+      position[index] = ( position[index] + 1 ) % parameters[index].values.size( );
+
+      if( position[index] != 0 )
+      {
+         return;
       }
-      else if( metaDataStream[index].code == 'A' )
+   }
+}
+
+/**
+ * @brief runSweep function.
+ *
+ * @details runs a config at every combination of the sweep parameters and
+ *          writes the makespan and utilization of each point as CSV.
+ *
+ * @param in: configFile, sweeps, workers, useCache, residentLimit
+ *
+ * @note Each point is the config with one value of each parameter put in
+ *       as if its "KEY: value" line came last, then checked like a config
+ *       file. Points run in virtual time on the batch worker threads with
+ *       their logs discarded, all sharing the config's meta-data file.
+ *       Rows go to standard output after every point has run, in order,
+ *       with the first parameter changing slowest; points the config
+ *       checks reject have status "config error". Each I/O device has a
+ *       busy time and a utilization column, its busy time over the
+ *       makespan and its units. Returns false if the config, a parameter
+ *       or the number of points cannot be used.
+ */
+bool runSweep( char configFile[], const vector<char *> &sweeps, int workers, bool useCache, int residentLimit )
+{
+   batchRun batch;
+   configData fileData = configData( );
+   configData scratch;
+   unordered_map<string, int> workloads;
+   vector<sweepParameter> parameters( sweeps.size( ) );
+   vector<int> position( sweeps.size( ), 0 );
+   streamsize oldPrecision = cout.precision( );
+   long long points = 1;
+   bool readFlag = true;
+   int index = 0;
+   int point = 0;
+   int device = 0;
+
+   batch.virtualTime = true;
+   batch.spinTime = 0;
+   batch.residentLimit = residentLimit;
+
+   readConfigData( fileData, configFile, readFlag );
+
+   if( readFlag == false )
+   {
+      return false;
+   }
+
+   for( index = 0; index < (int) sweeps.size( ); index++ )
+   {
+      if( parseSweep( sweeps[index], parameters[index] ) == false )
       {
-         if( strcmp( metaDataStream[index].description, "start" ) == 0 )
+         cout << sweeps[index] << " is not a sweep of KEY=LOW:HIGH[:STEP] or KEY=A,B,...\n";
+         return false;
+      }
+
+      scratch = fileData;
+      applyConfigEntry( scratch, parameters[index].key + ": " + parameters[index].values[0], readFlag );
+
+      if( readFlag == false )
+      {
+         return false;
+      }
+
+      points = points * parameters[index].values.size( );
+
+      if( points > MAX_SWEEP_POINTS )
+      {
+         cout << "A sweep may run at most " << MAX_SWEEP_POINTS << " points\n";
+         return false;
+      }
+   }
+
+   fileData.logData.logCriteria = "File";
+   fileData.logData.logFilePath = "/dev/null";
+   batch.jobs.resize( points );
+
+   for( point = 0; point < points; point++ )
+   {
+      batchJob &job = batch.jobs[point];
+
+      job.configFile = configFile;
+      job.metaFile = fileData.filePath;
+      job.fileData = fileData;
+      job.workload = -1;
+      job.status = "config error";
+      readFlag = true;
+
+      for( index = 0; index < (int) parameters.size( ); index++ )
+      {
+         applyConfigEntry( job.fileData, parameters[index].key + ": " + parameters[index].values[position[index]], readFlag );
+      }
+
+      checkConfigData( job.fileData, readFlag );
+
+      if( ( readFlag == true ) && ( addBatchWorkload( batch, workloads, job, useCache ) == false ) )
+      {
+         return false;
+      }
+
+      nextSweepPoint( parameters, position );
+   }
+
+   runBatchJobs( batch, workers );
+
+   configData &devices = batch.jobs[0].fileData;
+
+   for( index = 0; index < (int) parameters.size( ); index++ )
+   {
+      cout << csvField( parameters[index].key ) << ",";
+   }
+   cout << "status,makespan_sec,cpu_utilization,turnaround_mean_sec,context_switches";
+
+   for( device = 0; device < (int) devices.cycleData.size( ); device++ )
+   {
+      if( ioDevice( devices, device ) )
+      {
+         cout << "," << csvField( deviceColumn( devices.cycleData[device].componentName ) + "_busy_sec" )
+              << "," << csvField( deviceColumn( devices.cycleData[device].componentName ) + "_utilization" );
+      }
+   }
+
+   cout << endl;
+   cout << fixed << setprecision(6);
+
+   for( point = 0; point < points; point++ )
+   {
+      batchJob &job = batch.jobs[point];
+
+      for( index = 0; index < (int) parameters.size( ); index++ )
+      {
+         cout << csvField( parameters[index].values[position[index]] ) << ",";
+      }
+
+      cout << job.status;
+
+      if( job.status.compare( "ok" ) == 0 )
+      {
+         cout << "," << toSeconds( job.result.makespan ) << "," << cpuUtilization( job.result ) << ","
+              << toSeconds( job.result.totalTurnaround ) / max( job.result.processCount, 1 ) << ","
+              << job.result.switchCount;
+      }
+      else
+      {
+         cout << ",,,,";
+      }
+
+      for( device = 0; device < (int) devices.cycleData.size( ); device++ )
+      {
+         if( !ioDevice( devices, device ) )
          {
-            processObj.processState = START; 
-            processID++;
-            gettimeofday(&t2, NULL); 
-            elapsedTime = findTime( t1, t2 ); 
-            fout << setprecision(6) << elapsedTime << " - " << "OS: preparing process " << processID << endl;
-            gettimeofday(&t2, NULL); 
-            elapsedTime = findTime( t1, t2 ); 
-            fout << setprecision(6) << elapsedTime << " - " << "OS: starting process " << processID << endl;
+            continue;
          }
-         else if( strcmp( metaDataStream[index].description, "end" ) == 0 )
+
+         if( job.status.compare( "ok" ) == 0 )
+         {
+            cout << "," << toSeconds( job.result.deviceBusy[device] ) << ","
+                 << deviceUtilization( job.result, device, job.fileData.cycleData[device].quantity );
+         }
+         else
          {
-            processObj.processState = EXIT; 
-            gettimeofday(&t2, NULL); 
-            elapsedTime = findTime( t1, t2 ); 
-            fout << setprecision(6) << elapsedTime << " - " << "OS: removing process " << processID << endl;
+            cout << ",,";
          }
       }
-      else if( metaDataStream[index].code == 'M' )
+
+      cout << endl;
+      nextSweepPoint( parameters, position );
+   }
+
+   cout.unsetf( ios::floatfield );
+   cout.precision( oldPrecision );
+
+   return true;
+}
+
+/**
+ * @brief cycleTimesOnly function.
+ *
+ * @details tells whether two configs differ in nothing but cycle times.
+ *
+ * @param in: from, to
+ *
+ * @note The devices must be the same ones, in the same order and with the
+ *       same quantities. The version and log entries are not compared;
+ *       neither changes a run whose log is discarded.
+ */
+static bool cycleTimesOnly( const configData &from, const configData &to )
+{
+   int index = 0;
+
+   if( ( from.filePath.compare( to.filePath ) != 0 ) || ( from.cycleData.size( ) != to.cycleData.size( ) ) ||
+       ( from.systemMemorySize != to.systemMemorySize ) || ( from.blockMemorySize != to.blockMemorySize ) ||
+       ( from.schedulingCode != to.schedulingCode ) || ( from.memoryCode != to.memoryCode ) ||
+       ( from.pagingCode != to.pagingCode ) || ( from.tlbEntries != to.tlbEntries ) ||
+       ( from.quantumNumber != to.quantumNumber ) || ( from.contextSwitchTime != to.contextSwitchTime ) ||
+       ( from.processorCores != to.processorCores ) )
+   {
+      return false;
+   }
+
+   for( index = 0; index < (int) from.cycleData.size( ); index++ )
+   {
+      if( ( from.cycleData[index].componentName != to.cycleData[index].componentName ) ||
+          ( from.cycleData[index].quantity != to.cycleData[index].quantity ) )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/**
+ * @brief retimeRun function.
+ *
+ * @details works out the figures of a one-application run at new cycle
+ *          times from its figures at the old ones, without running it.
+ *
+ * @param in: cache (resolved against fileData), profile, fileData
+ *
+ * @param out: result (the figures at the old cycle times on entry)
+ *
+ * @note A lone process runs its operations back to back from time zero on
+ *       one core (see runSequential), so its makespan and turnaround are
+ *       the sum of its operation times and that core's busy time the sum
+ *       of its processing and memory times. Which core it is, the memory
+ *       figures and the zero waiting and response do not depend on cycle
+ *       times. I/O on a device the device pool gives no units is skipped,
+ *       as the engine skips it.
+ */
+static void retimeRun( const metaCache &cache, const metaProfile &profile, configData &fileData, simResult &result )
+{
+   simTime cpuTime = 0;
+   simTime ioTime = 0;
+   int processor = findComponent( fileData, "Processor" );
+   int core = 0;
+   int name = 0;
+   int device = 0;
+   string component;
+
+   for( name = 1; name < MDB_NAMES; name++ )
+   {
+      cpuTime = cpuTime + profile.cpuCycles[name] * cache.cycleTimes[name];
+      device = cache.devices[name];
+
+      if( ( profile.ioCycles[name] > 0 ) && ( device >= 0 ) )
       {
-         for( indexTwo = 0; indexTwo < 8; indexTwo++ )
+         component = fileData.cycleData[device].componentName;
+
+         if( ( component.compare( "Processor" ) != 0 ) && ( component.compare( "Memory" ) != 0 ) )
          {
-            if( fileData.cycleData[indexTwo].componentName.compare("Memory") == 0 )
-            {
-               if( strcmp( metaDataStream[index].description, "allocate" ) == 0 )
-         		{
-                  processObj.processState = RUNNING;;
-            		cycles = ( metaDataStream[index].cycles * fileData.cycleData[indexTwo].time ) / 1000.0; 
-  					   gettimeofday(&t2, NULL); 
-                  wait( t1, t2, cycles ); 
-                  elapsedTime = findTime( t1, t2 );
-               	fout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": allocating memory"<< endl; 
-               	gettimeofday(&t2, NULL); 
-                  elapsedTime = findTime( t1, t2 ); 
-               	fout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": memory allocated at ";
-                  fout << "0x" << setfill('0');
-                  fout << setw(8) << hex << memoryNum << endl;
-                  memoryNum = allocateMemory( memoryNum, fileData.blockMemorySize, fileData.systemMemorySize);
-         		}
-               else if( strcmp( metaDataStream[index].description, "block" ) == 0 )
-         		{
-                  processObj.processState = READY;
-            		cycles = ( metaDataStream[index].cycles * fileData.cycleData[indexTwo].time ) / 1000.0; 
-  					   gettimeofday(&t2, NULL); 
-                  wait( t1, t2, cycles );  
-                  elapsedTime = findTime( t1, t2 );  
-               	fout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": start memory blocking"<< endl;
-               	gettimeofday(&t2, NULL); 
-                  elapsedTime = findTime( t1, t2 ); 
-               	fout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": end memory blocking"<< endl;
-         		}
-            }
+            ioTime = ioTime + profile.ioCycles[name] * cache.cycleTimes[name];
          }
       }
-      else if( ( metaDataStream[index].code == 'I' ) || ( metaDataStream[index].code == 'O' ) )
+   }
+
+   for( name = 0; name < (int) result.coreBusy.size( ); name++ )
+   {
+      if( result.coreBusy[name] >= result.coreBusy[core] )
       {
-         for( indexTwo = 0; indexTwo < 8; indexTwo++ )
+         core = name;
+      }
+   }
+
+   fill( result.coreBusy.begin( ), result.coreBusy.end( ), 0 );
+   if( !result.coreBusy.empty( ) )
+   {
+      result.coreBusy[core] = cpuTime;
+   }
+
+   result.makespan = cpuTime + ioTime;
+   result.cpuBusy = cpuTime;
+   result.totalTurnaround = result.makespan;
+   result.maxTurnaround = result.makespan;
+   result.quantum = 0;
+
+   if( processor >= 0 )
+   {
+      result.quantum = (simTime) fileData.cycleData[processor].time * USEC_PER_MSEC * max( fileData.quantumNumber, 1 );
+   }
+}
+
+/**
+ * @brief answerWhatIf function.
+ *
+ * @details gives the summary of a config in a what-if session.
+ *
+ * @param in: session, fileData
+ *
+ * @note When the config changes only cycle times from the last answer's
+ *       and the workload is one application without paging, the answer is
+ *       retimed from the last one in a pass over the component names.
+ *       Any other change is simulated again in virtual time from the
+ *       mapped workload, with the log discarded.
+ */
+static void answerWhatIf( whatIfSession &session, configData &fileData )
+{
+   long long started = readMonotonic( );
+   batchJob &job = session.batch.jobs[0];
+   metaCache cache = metaCache( );
+   streamsize oldPrecision = cout.precision( );
+   bool retimed = false;
+
+   if( session.answered && session.profiled && ( session.profile.applications == 1 ) && ( job.status.compare( "ok" ) == 0 ) &&
+       ( findReplacementPolicy( fileData.pagingCode ) == NO_PAGING ) && cycleTimesOnly( job.fileData, fileData ) &&
+       ( shareMetaCache( cache, session.batch.workloads[0].cache, fileData ) == true ) )
+   {
+      retimeRun( cache, session.profile, fileData, job.result );
+      job.fileData = fileData;
+      retimed = true;
+   }
+   else
+   {
+      job.status = "ok";
+      job.result = simResult( );
+      job.fileData = fileData;
+      runBatchJob( session.batch, job );
+   }
+
+   session.answered = true;
+   unloadMetaCache( cache );
+
+   if( job.status.compare( "ok" ) == 0 )
+   {
+      printSimulationSummary( job.result );
+   }
+   else
+   {
+      cout << "The run failed: " << job.status << endl;
+   }
+
+   cout << "Answered in " << fixed << setprecision(3) << ( readMonotonic( ) - started ) / 1e6 << " ms"
+        << ( retimed ? " by retiming the last answer" : " by simulating" ) << endl;
+   cout.unsetf( ios::floatfield );
+   cout.precision( oldPrecision );
+}
+
+/**
+ * @brief runWhatIf function.
+ *
+ * @details runs a config, then answers what-if questions about it: each
+ *          line read from standard input changes the config and the
+ *          summary of the changed config is printed.
+ *
+ * @param in: configFile, useCache, residentLimit
+ *
+ * @note A line is a config entry such as "Printer cycle time (msec): 40",
+ *       put in as if it came last in the config file and checked like
+ *       one; changes add up until "reset" goes back to the config file.
+ *       "quit" or the end of input ends the session. Blank lines and
+ *       lines starting with '#' are ignored, and a line the checks reject
+ *       leaves the config as it was. The meta-data file is parsed or
+ *       mapped once for the whole session, and the cycles of each of its
+ *       component names totalled, so a change of cycle times alone is
+ *       answered without a run when it can be (see answerWhatIf). The
+ *       File Path cannot change. Returns false if the config or its
+ *       meta-data file cannot be used.
+ */
+bool runWhatIf( char configFile[], bool useCache, int residentLimit )
+{
+   whatIfSession session;
+   unordered_map<string, int> workloads;
+   configData baseData = configData( );
+   configData fileData;
+   configData changed;
+   string line;
+   bool readFlag = true;
+
+   session.batch.virtualTime = true;
+   session.batch.spinTime = 0;
+   session.batch.residentLimit = residentLimit;
+   session.profiled = false;
+   session.answered = false;
+
+   readConfigData( baseData, configFile, readFlag );
+
+   if( readFlag == false )
+   {
+      return false;
+   }
+
+   baseData.logData.logCriteria = "File";
+   baseData.logData.logFilePath = "/dev/null";
+   session.batch.jobs.resize( 1 );
+
+   batchJob &job = session.batch.jobs[0];
+
+   job.configFile = configFile;
+   job.metaFile = baseData.filePath;
+   job.fileData = baseData;
+   job.workload = -1;
+
+   if( ( addBatchWorkload( session.batch, workloads, job, useCache ) == false ) || ( job.status.compare( "ok" ) != 0 ) )
+   {
+      return false;
+   }
+
+   if( session.batch.workloads[0].cached == true )
+   {
+      profileMetaCache( session.batch.workloads[0].cache, session.profile );
+      session.profiled = true;
+   }
+   else
+   {
+      cout << job.metaFile << " has no .mdb cache, so every answer parses it again\n";
+   }
+
+   cout << "What if: " << configFile << endl;
+   fileData = baseData;
+   answerWhatIf( session, fileData );
+
+   while( getline( cin, line ) )
+   {
+      line.erase( line.find_last_not_of( " \t\r" ) + 1 );
+      line.erase( 0, line.find_first_not_of( " \t" ) );
+
+      if( line.empty( ) || ( line[0] == '#' ) )
+      {
+         continue;
+      }
+
+      if( line.compare( "quit" ) == 0 )
+      {
+         break;
+      }
+
+      if( line.compare( "reset" ) == 0 )
+      {
+         changed = baseData;
+      }
+      else
+      {
+         changed = fileData;
+         readFlag = true;
+         applyConfigEntry( changed, line, readFlag );
+         checkConfigData( changed, readFlag );
+
+         if( ( readFlag == true ) && ( changed.filePath.compare( baseData.filePath ) != 0 ) )
          {
-            length = strlen( metaDataStream[index].description ); 
+            cout << "The meta-data file cannot change in a what-if session\n";
+            readFlag = false;
+         }
 
-            if( fileData.cycleData[indexTwo].componentName.compare(1, length, metaDataStream[index].description, 1, length) == 0 )
-            {
-               processObj.processState = WAITING;
-            	cycles = ( metaDataStream[index].cycles * fileData.cycleData[indexTwo].time ) / 1000.0; 
-  					gettimeofday(&t2, NULL); 
-               elapsedTime = findTime( t1, t2 ); 
-               fout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": start ";
-               fout << metaDataStream[index].description; 
-               if( metaDataStream[index].code == 'I' )
-               {
-               	fout << " input\n"; 
-               }
-               if( metaDataStream[index].code == 'O' )
-               {
-               	fout << " output\n"; 
-               } 
-               td.t1 = t1; 
-               td.t2 = t2; 
-               td.cycleTime2 = cycles; 
-               sem_init(&mutex, 0, 1);
-               rc = pthread_create(&OSThreads, &attr, pWait, (void*) &td);
-					if(rc)
- 					{
-						fout << "Error: cannot create thread " << rc << endl; 
- 						exit(-1); 
-					}
-               processObj.processState = READY;
-               rc = pthread_join(OSThreads, &status);
-               sem_init(&mutex, 0, 1);
-      
-      			if( rc )
-      			{
-         			fout << "Error: can't join " << rc << endl;
-         			exit(-1);
-      			}
-
-               gettimeofday(&t2, NULL);
-               elapsedTime = findTime( t1, t2 ); 
-               fout << setprecision(6) << elapsedTime << " - " << "Process" << processID << ": end ";
-               fout << metaDataStream[index].description; 
-               if( metaDataStream[index].code == 'I' )
-               {
-               	fout << " input"; 
-               }
-               if( metaDataStream[index].code == 'O' )
-               {
-               	fout << " output"; 
-               }
-               
-               if( strcmp( metaDataStream[index].description, "hard drive" ) == 0 ) 
-               {
-                  fout << " on HDD " << indexFour;
-                  indexFour++;
-                  if( fileData.hardDriveQuantity != 0 )
-                  	indexFour = indexFour % fileData.hardDriveQuantity;
-               }
-               if( strcmp( metaDataStream[index].description, "printer" ) == 0 ) 
-               {
-                  fout << " on PRNTR " << indexFive;
-                  indexFive++;
-                  if( fileData.printerQuantity != 0 )
-                  	indexFive = indexFive % fileData.printerQuantity;
-               }
-               fout << endl;
-            }
+         if( readFlag == false )
+         {
+            continue;
          }
+
+         changed.logData = baseData.logData;
       }
-      int pthread_mutex_unlock(pthread_mutex_t *mutex);
+
+      cout << "What if: " << line << endl;
+      fileData = changed;
+      answerWhatIf( session, fileData );
    }
 
-   pthread_exit(NULL);
-}
+   unloadMetaCache( session.batch.workloads[0].cache );
 
+   return true;
+}
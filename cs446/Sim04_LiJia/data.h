@@ -0,0 +1,135 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file data.h
+ *
+ * @brief Shared data structures for the operating system simulator.
+ *
+ * @author Jia Li
+ *
+ * @details Declares the configuration, meta-data and process structures
+ *          read in by data.cpp and used by the simulator modules.
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Moved out of data.cpp
+ *
+ * @Note None
+ */
+
+// PRECOMPILER DIRECTIVES //////////////////////////////////////////////////////
+
+#ifndef DATA_H
+#define DATA_H
+
+// Header files ///////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "SimClock.h"
+
+using namespace std;
+
+// Global Constants //////////////////////////////////////////////////////
+
+const int START = 1;
+const int READY = 2;
+const int RUNNING = 3;
+const int WAITING = 4;
+const int EXIT = 5;
+
+// Structures //////////////////////////////////////////////////////
+
+// meta-data operations, resolved when the meta-data is read
+enum opCode
+{
+   OP_SYSTEM,
+   OP_APP_START,
+   OP_APP_END,
+   OP_RUN,
+   OP_ALLOCATE,
+   OP_BLOCK,
+   OP_INPUT,
+   OP_OUTPUT,
+   OP_SKIP
+};
+
+struct opRecord
+{
+   simTime duration;
+   int device;
+   unsigned char code;
+};
+
+struct PCB
+{
+   int processState;
+   int processID;
+
+   // meta-data ops of the application, A(start) and A(end) excluded
+   vector<opRecord> ops;
+   int nextOp;
+
+   bool started;
+   simTime arrival;
+   simTime finish;
+
+   // scheduling figures; times are planned operation times
+   simTime totalTime;
+   simTime remainingTime;
+   simTime opRemaining;
+   int priority;
+   simTime readySince;
+   simTime waitingTime;
+   simTime firstRun;
+
+   // core the process last ran on, -1 before its first run
+   int core;
+
+   // paging: references left in the current M(block), -1 outside one,
+   // and the page fault being waited for
+   int pageRefs;
+   bool pageFault;
+   simTime faultStart;
+
+   // real time: how much longer the process's operations took than asked
+   simTime drift;
+};
+
+// one device type of the config, with its cycle time and unit count
+struct cycleTime
+{
+   string componentName;
+   int time;
+   int quantity;
+};
+
+struct logInfo
+{
+   string logCriteria;
+   string logFilePath;
+};
+
+struct configData
+{
+   string filePath;
+   float versionNum;
+
+   // device registry in config order; deviceIndex finds an entry by its
+   // name with the first letter in lower case
+   vector<cycleTime> cycleData;
+   unordered_map<string, int> deviceIndex;
+
+   logInfo logData;
+   int systemMemorySize;
+   int blockMemorySize;
+   string schedulingCode;
+   string memoryCode;
+   string pagingCode;
+   int tlbEntries;
+   int quantumNumber;
+   int contextSwitchTime;
+   int processorCores;
+};
+
+#endif // DATA_H
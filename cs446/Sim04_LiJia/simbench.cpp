@@ -0,0 +1,349 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file simbench.cpp
+ *
+ * @brief Scaling benchmark for the CS 446/646 operating system simulator.
+ *
+ * @details Generates the default simgen workload at each size with a fixed
+ *          seed, runs Sim04 on it in virtual time, and prints one row per
+ *          size:
+ *
+ *          parse  - operations per second of Sim04 --parse-only
+ *          engine - operations per second of a run that maps the .mdb
+ *                   cache, logging to /dev/null
+ *          RSS    - peak resident size of a run that parses the text
+ *          log    - log bytes per second of a cached run logging to a file
+ *
+ *          Usage: simbench [--sizes N,N,...] [--dir DIR] [--sim PATH] [--keep]
+ *
+ *          The workloads go in DIR, /tmp/simbench by default, and are
+ *          removed after each size unless --keep is given. `make bench`
+ *          runs it with the sizes in BENCH_SIZES.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include "Workload.h"
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+static const char DEFAULT_SIZES[] = "1000,10000,100000,1000000";
+
+static const char DEFAULT_DIR[] = "/tmp/simbench";
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct benchRun
+{
+   bool ok;
+   double seconds;
+   long peakKbytes;
+};
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief nowSeconds function.
+ *
+ * @details monotonic clock reading in seconds.
+ *
+ * @param in: none
+ *
+ * @note N/A.
+ */
+static double nowSeconds( )
+{
+   struct timespec now;
+
+   clock_gettime( CLOCK_MONOTONIC, &now );
+
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief writeConfig function.
+ *
+ * @details writes the config a benchmark run uses.
+ *
+ * @param in: path, metaPath, logPath
+ *
+ * @note The sample config's cycle times on four cores under round robin,
+ *       with two hard drives and two printers.
+ */
+static bool writeConfig( const string &path, const string &metaPath, const string &logPath )
+{
+   FILE *out = fopen( path.c_str( ), "w" );
+
+   if( out == NULL )
+   {
+      return false;
+   }
+
+   fprintf( out, "Start Simulator Configuration File\n"
+                 "Version/Phase: 1.0\n"
+                 "File Path: %s\n"
+                 "Processor cycle time (msec): 10\n"
+                 "Monitor display time (msec): 25\n"
+                 "Hard drive cycle time (msec): 50\n"
+                 "Printer cycle time (msec): 500\n"
+                 "Keyboard cycle time (msec): 1000\n"
+                 "Memory cycle time (msec): 35\n"
+                 "Mouse cycle time (msec): 20\n"
+                 "Speaker cycle time (msec): 10\n"
+                 "Log: Log to File\n"
+                 "Log File Path: %s\n"
+                 "Hard drive quantity: 2\n"
+                 "Printer quantity: 2\n"
+                 "CPU Scheduling Code: RR\n"
+                 "Processor Quantum Number: 5\n"
+                 "Processor cores: 4\n"
+                 "End Simulator Configuration File\n",
+            metaPath.c_str( ), logPath.c_str( ) );
+
+   return fclose( out ) == 0;
+}
+
+/**
+ * @brief runSimulator function.
+ *
+ * @details runs Sim04 on a config in virtual time and measures it.
+ *
+ * @param in: simPath, config, mode (an extra Sim04 flag, or NULL)
+ *
+ * @note Sim04's own output is discarded. The run fails if Sim04 cannot be
+ *       started or does not exit cleanly.
+ */
+static benchRun runSimulator( const string &simPath, const string &config, const char mode[] )
+{
+   benchRun run = { false, 0, 0 };
+   vector<const char *> args;
+   struct rusage usage;
+   double started = nowSeconds( );
+   int status = 0;
+   int devNull = -1;
+   pid_t child = 0;
+
+   args.push_back( simPath.c_str( ) );
+   args.push_back( "--virtual-time" );
+   if( mode != NULL )
+   {
+      args.push_back( mode );
+   }
+   args.push_back( config.c_str( ) );
+   args.push_back( NULL );
+
+   child = fork( );
+
+   if( child == 0 )
+   {
+      devNull = open( "/dev/null", O_WRONLY );
+      dup2( devNull, STDOUT_FILENO );
+      dup2( devNull, STDERR_FILENO );
+      execv( simPath.c_str( ), (char * const *) &args[0] );
+      _exit( 127 );
+   }
+
+   if( ( child < 0 ) || ( wait4( child, &status, 0, &usage ) != child ) )
+   {
+      return run;
+   }
+
+   run.seconds = nowSeconds( ) - started;
+   run.peakKbytes = usage.ru_maxrss;
+   run.ok = WIFEXITED( status ) && ( WEXITSTATUS( status ) == 0 );
+
+   return run;
+}
+
+/**
+ * @brief fileSize function.
+ *
+ * @details size of a file in bytes, 0 if it is missing.
+ *
+ * @param in: path
+ *
+ * @note N/A.
+ */
+static long long fileSize( const string &path )
+{
+   struct stat info;
+
+   return ( stat( path.c_str( ), &info ) == 0 ) ? info.st_size : 0;
+}
+
+/**
+ * @brief benchSize function.
+ *
+ * @details generates, runs and reports one workload size.
+ *
+ * @param in: simPath, ops, keep
+ *
+ * @note Runs in the benchmark directory, so the config's paths stay short
+ *       enough for Sim04. Returns false if a step fails.
+ */
+static bool benchSize( const string &simPath, long long ops, bool keep )
+{
+   ostringstream name;
+   string base, metaPath, config, logConfig, logPath;
+   workloadSpec spec;
+   benchRun parsed, full, cached, logged;
+   FILE *out = NULL;
+   bool ok = true;
+
+   name << "w" << ops;
+   base = name.str( );
+   metaPath = base + ".mdf";
+   config = base + ".conf";
+   logConfig = base + "l.conf";
+   logPath = base + ".log";
+
+   defaultWorkload( spec, ops );
+   out = fopen( metaPath.c_str( ), "w" );
+
+   if( ( out == NULL ) || !writeWorkload( spec, out ) || ( fclose( out ) != 0 ) ||
+       !writeConfig( config, metaPath, "/dev/null" ) || !writeConfig( logConfig, metaPath, logPath ) )
+   {
+      printf( "%12lld  workload could not be written\n", ops );
+      return false;
+   }
+
+   remove( ( base + ".mdb" ).c_str( ) );
+
+   parsed = runSimulator( simPath, config, "--parse-only" );
+   full = runSimulator( simPath, config, NULL );
+   cached = runSimulator( simPath, config, NULL );
+   logged = runSimulator( simPath, logConfig, NULL );
+   ok = parsed.ok && full.ok && cached.ok && logged.ok;
+
+   if( !ok )
+   {
+      printf( "%12lld  Sim04 failed\n", ops );
+   }
+   else
+   {
+      printf( "%12lld %9.1f %13.3f %14.3f %12.1f %10.1f\n", ops, fileSize( metaPath ) / 1e6,
+              ops / parsed.seconds / 1e6, ops / cached.seconds / 1e6, full.peakKbytes / 1024.0,
+              fileSize( logPath ) / logged.seconds / 1e6 );
+   }
+
+   fflush( stdout );
+
+   if( !keep )
+   {
+      remove( metaPath.c_str( ) );
+      remove( ( base + ".mdb" ).c_str( ) );
+      remove( config.c_str( ) );
+      remove( logConfig.c_str( ) );
+      remove( logPath.c_str( ) );
+   }
+
+   return ok;
+}
+
+/**
+ * @brief main function.
+ *
+ * @details reads the options and benchmarks each size in turn.
+ *
+ * @param in: argc, argv[]
+ *
+ * @note Stops at the first size that fails.
+ */
+int main( int argc, char* argv[] )
+{
+   const char *sizes = DEFAULT_SIZES;
+   const char *dir = DEFAULT_DIR;
+   const char *sim = "./Sim04";
+   char simPath[PATH_MAX];
+   bool keep = false;
+   bool valid = true;
+   const char *next = NULL;
+   char *end = NULL;
+   long long ops = 0;
+   int index = 0;
+
+   for( index = 1; valid && ( index < argc ); index++ )
+   {
+      if( ( strcmp( argv[index], "--sizes" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         sizes = argv[++index];
+      }
+      else if( ( strcmp( argv[index], "--dir" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         dir = argv[++index];
+      }
+      else if( ( strcmp( argv[index], "--sim" ) == 0 ) && ( index + 1 < argc ) )
+      {
+         sim = argv[++index];
+      }
+      else if( strcmp( argv[index], "--keep" ) == 0 )
+      {
+         keep = true;
+      }
+      else
+      {
+         valid = false;
+      }
+   }
+
+   if( !valid )
+   {
+      printf( "Usage: simbench [--sizes N,N,...] [--dir DIR] [--sim PATH] [--keep]. Abort.\n" );
+      return 1;
+   }
+
+   if( realpath( sim, simPath ) == NULL )
+   {
+      printf( "%s is not there, build Sim04 first\n", sim );
+      return 1;
+   }
+
+   mkdir( dir, 0755 );
+
+   if( chdir( dir ) != 0 )
+   {
+      printf( "%s cannot be used as the benchmark directory\n", dir );
+      return 1;
+   }
+
+   printf( "%12s %9s %13s %14s %12s %10s\n", "ops", "mdf MB", "parse Mops/s", "engine Mops/s", "peak RSS MB", "log MB/s" );
+
+   for( next = sizes; *next != '\0'; next = ( *end == ',' ) ? end + 1 : end )
+   {
+      ops = strtoll( next, &end, 10 );
+
+      if( ( end == next ) || ( ops <= 0 ) )
+      {
+         printf( "%s is not a list of sizes\n", sizes );
+         return 1;
+      }
+
+      if( !benchSize( simPath, ops, keep ) )
+      {
+         return 1;
+      }
+   }
+
+   return 0;
+}
@@ -0,0 +1,133 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file simgen.cpp
+ *
+ * @brief Synthetic meta-data generator for the CS 446/646 operating system
+ *        simulator.
+ *
+ * @details Writes a workload of any size, from a few operations to a few
+ *          hundred million, as a .mdf file Sim04 reads like the sample ones.
+ *
+ *          Usage: simgen [--ops N] [--processes N] [--mix R,A,B,I,O]
+ *                        [--cycles fixed:N | uniform:MIN-MAX | exp:MEAN]
+ *                        [--seed N] <output file | ->
+ *
+ *          --mix gives the weights of P(run), M(allocate), M(block), I()
+ *          and O() operations. The defaults are 1000 operations, one
+ *          application per 20 of them, a 50,10,10,15,15 mix, uniform:1-20
+ *          cycles and seed 1.
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include "Workload.h"
+
+using namespace std;
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief main function.
+ *
+ * @details reads the options and writes the workload.
+ *
+ * @param in: argc, argv[]
+ *
+ * @note --processes defaults to one application per 20 operations of the
+ *       --ops given, wherever the options are.
+ */
+int main( int argc, char* argv[] )
+{
+   workloadSpec spec;
+   long long processes = 0;
+   const char *outFile = NULL;
+   const char *value = NULL;
+   bool valid = true;
+   FILE *out = NULL;
+   int index = 0;
+
+   defaultWorkload( spec, 1000 );
+
+   for( index = 1; valid && ( index < argc ); index++ )
+   {
+      value = ( index + 1 < argc ) ? argv[index + 1] : NULL;
+
+      if( ( strcmp( argv[index], "--ops" ) == 0 ) && ( value != NULL ) )
+      {
+         spec.ops = atoll( value );
+         valid = ( spec.ops > 0 );
+         index++;
+      }
+      else if( ( strcmp( argv[index], "--processes" ) == 0 ) && ( value != NULL ) )
+      {
+         processes = atoll( value );
+         valid = ( processes > 0 );
+         index++;
+      }
+      else if( ( strcmp( argv[index], "--mix" ) == 0 ) && ( value != NULL ) )
+      {
+         valid = parseMix( spec, value );
+         index++;
+      }
+      else if( ( strcmp( argv[index], "--cycles" ) == 0 ) && ( value != NULL ) )
+      {
+         valid = parseCycles( spec, value );
+         index++;
+      }
+      else if( ( strcmp( argv[index], "--seed" ) == 0 ) && ( value != NULL ) )
+      {
+         spec.seed = strtoull( value, NULL, 10 );
+         index++;
+      }
+      else if( outFile == NULL )
+      {
+         outFile = argv[index];
+      }
+      else
+      {
+         valid = false;
+      }
+   }
+
+   if( !valid || ( outFile == NULL ) )
+   {
+      cout << "Usage: simgen [--ops N] [--processes N] [--mix R,A,B,I,O] "
+           << "[--cycles fixed:N | uniform:MIN-MAX | exp:MEAN] [--seed N] <output file | ->. Abort.\n";
+      return 1;
+   }
+
+   spec.processes = ( processes > 0 ) ? processes : max( spec.ops / 20, 1LL );
+   out = ( strcmp( outFile, "-" ) == 0 ) ? stdout : fopen( outFile, "w" );
+
+   if( out == NULL )
+   {
+      cout << outFile << " cannot be written\n";
+      return 1;
+   }
+
+   valid = writeWorkload( spec, out );
+
+   if( out != stdout )
+   {
+      valid = ( fclose( out ) == 0 ) && valid;
+   }
+
+   if( !valid )
+   {
+      cout << outFile << " could not be written in full\n";
+      return 1;
+   }
+
+   return 0;
+}
@@ -0,0 +1,471 @@
+// Program Information /////////////////////////////////////////////////////////
+/**
+ * @file simtrace.cpp
+ *
+ * @brief Binary trace decoder for the CS 446/646 operating system simulator.
+ *
+ * @details Reads a trace written by Sim04 --trace and prints it as the
+ *          simulator's text log, byte for byte what the run would have
+ *          logged, as CSV with one row per event, or as Chrome Trace Event
+ *          JSON that chrome://tracing and the Perfetto UI open as timelines.
+ *
+ *          Usage: simtrace [--csv | --chrome] <trace file>
+ *
+ * @author Jia Li
+ *
+ * @version 1.00
+ *          Jia Li (16 October 2026)
+ *          Original Code
+ */
+
+// HEADER FILES ////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <set>
+#include <algorithm>
+#include "LogSink.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// GLOBAL CONSTANTS ////////////////////////////////////////////////////////////
+
+// event names for CSV, in logEventType order
+static const char *EVENT_NAMES[] =
+{
+   "SIM_START",
+   "PROCESS_PREPARE",
+   "PROCESS_START",
+   "PROCESS_REMOVE",
+   "CPU_START",
+   "CPU_END",
+   "CPU_PREEMPT",
+   "MEMORY_ALLOCATE",
+   "MEMORY_ALLOCATED",
+   "MEMORY_FAILED",
+   "BLOCK_START",
+   "BLOCK_END",
+   "INPUT_START",
+   "INPUT_END",
+   "OUTPUT_START",
+   "OUTPUT_END",
+   "PAGE_FAULT",
+   "PAGE_LOADED"
+};
+
+// bytes of output buffered before each write
+const int OUTPUT_BUFFER = 1 << 20;
+
+// Chrome trace track groups
+const int CHROME_PROCESSES = 1;
+const int CHROME_CORES = 2;
+const int CHROME_DEVICES = 3;
+
+// Structures //////////////////////////////////////////////////////////////////
+
+struct chromeProcess
+{
+   simTime lifeStart;
+   simTime opStart;
+
+   // core the process last ran on, -1 if not known
+   int core;
+};
+
+struct chromeUnit
+{
+   int track;
+   simTime lastEnd;
+};
+
+// Function definitions ////////////////////////////////////////////////////////
+
+bool readTrace( mappedFile &file, logSink &sink, const traceRecord *&records, size_t &count );
+
+void writeChromeTrace( logSink &sink, const traceRecord records[], size_t count );
+
+// Function implementations ////////////////////////////////////////////////////
+
+/**
+ * @brief main function.
+ *
+ * @details decodes a trace file to standard output.
+ *
+ * @param in: argc, argv[]
+ *
+ * @note --csv selects CSV and --chrome Chrome Trace Event JSON; the text
+ *       log is the default.
+ */
+int main( int argc, char* argv[] )
+{
+   mappedFile file;
+   logSink sink = logSink( );
+   const traceRecord *records = NULL;
+   size_t count = 0;
+   size_t index = 0;
+   bool csv = false;
+   bool chrome = false;
+   char *traceFile = NULL;
+   char line[LOG_LINE_SIZE + 1];
+   const char *device = "";
+   logEvent event;
+   int length = 0;
+
+   for( index = 1; index < (size_t) argc; index++ )
+   {
+      if( strcmp( argv[index], "--csv" ) == 0 )
+      {
+         csv = true;
+      }
+      else if( strcmp( argv[index], "--chrome" ) == 0 )
+      {
+         chrome = true;
+      }
+      else if( traceFile == NULL )
+      {
+         traceFile = argv[index];
+      }
+      else
+      {
+         traceFile = NULL;
+         break;
+      }
+   }
+
+   if( traceFile == NULL )
+   {
+      cout << "Usage: simtrace [--csv | --chrome] <trace file>. Abort.\n";
+      return 1;
+   }
+
+   if( mapFile( file, traceFile ) == false )
+   {
+      cout << traceFile << " is either an empty trace file or an invalid filename\n";
+      return 1;
+   }
+
+   if( readTrace( file, sink, records, count ) == false )
+   {
+      cout << traceFile << " is not a simulator trace file\n";
+      unmapFile( file );
+      return 1;
+   }
+
+   setvbuf( stdout, NULL, _IOFBF, OUTPUT_BUFFER );
+
+   if( chrome )
+   {
+      writeChromeTrace( sink, records, count );
+      fflush( stdout );
+      unmapFile( file );
+      return 0;
+   }
+
+   if( csv )
+   {
+      fputs( "time_usec,event,process,device,instance,address\n", stdout );
+   }
+
+   for( index = 0; index < count; index++ )
+   {
+      event.time = records[index].time;
+      event.type = records[index].type;
+      event.processID = records[index].processID;
+      event.device = records[index].device;
+      event.instance = records[index].instance;
+      event.address = records[index].address;
+
+      if( !csv )
+      {
+         length = formatLogEvent( sink, event, line );
+         fwrite( line, 1, length, stdout );
+         continue;
+      }
+
+      device = "";
+
+      if( ( event.device >= 0 ) && ( event.device < (int) sink.deviceNames.size( ) ) )
+      {
+         device = sink.deviceNames[event.device].c_str( );
+      }
+
+      printf( "%lld,%s,%d,%s,%d,0x%08x\n", event.time,
+              ( event.type < (int) ( sizeof( EVENT_NAMES ) / sizeof( EVENT_NAMES[0] ) ) ) ? EVENT_NAMES[event.type] : "UNKNOWN",
+              event.processID, device, event.instance, event.address );
+   }
+
+   fflush( stdout );
+   unmapFile( file );
+
+   return 0;
+}
+
+/**
+ * @brief readTrace function.
+ *
+ * @details checks a mapped trace file and reads its name tables.
+ *
+ * @param in: file
+ *
+ * @param out: sink (device and unit names), records, count
+ *
+ * @note Returns false if the magic, version or record size do not match
+ *       this build, or the file is cut short. A run that stopped while
+ *       writing leaves a partial last record, which is ignored.
+ */
+bool readTrace( mappedFile &file, logSink &sink, const traceRecord *&records, size_t &count )
+{
+   const traceHeader *header = (const traceHeader *) file.data;
+   const traceName *names = NULL;
+   size_t start = 0;
+   unsigned int index = 0;
+
+   if( ( file.size < sizeof( traceHeader ) ) ||
+       ( memcmp( header->magic, TRACE_MAGIC, sizeof( TRACE_MAGIC ) ) != 0 ) ||
+       ( header->version != TRACE_VERSION ) ||
+       ( header->recordSize != sizeof( traceRecord ) ) )
+   {
+      return false;
+   }
+
+   start = sizeof( traceHeader ) + header->nameCount * sizeof( traceName );
+
+   if( file.size < start )
+   {
+      return false;
+   }
+
+   names = (const traceName *) ( file.data + sizeof( traceHeader ) );
+
+   for( index = 0; index < header->nameCount; index++ )
+   {
+      sink.deviceNames.push_back( string( names[index].device, strnlen( names[index].device, TRACE_NAME_SIZE ) ) );
+      sink.unitNames.push_back( string( names[index].unit, strnlen( names[index].unit, TRACE_NAME_SIZE ) ) );
+   }
+
+   records = (const traceRecord *) ( file.data + start );
+   count = ( file.size - start ) / sizeof( traceRecord );
+
+   return true;
+}
+
+/**
+ * @brief chromeSlice function.
+ *
+ * @details prints one complete event of the Chrome trace.
+ *
+ * @param in: first, name, pid, tid, start, end
+ *
+ * @note Times are already in microseconds, the unit the format uses.
+ */
+static void chromeSlice( bool &first, const string &name, int pid, int tid, simTime start, simTime end )
+{
+   printf( "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%lld,\"dur\":%lld}",
+           first ? "\n" : ",\n", name.c_str( ), pid, tid, start, end - start );
+   first = false;
+}
+
+/**
+ * @brief chromeName function.
+ *
+ * @details prints the metadata event that names a track or track group.
+ *
+ * @param in: first, kind ("process_name" or "thread_name"), pid, tid, name
+ *
+ * @note N/A.
+ */
+static void chromeName( bool &first, const char kind[], int pid, int tid, const string &name )
+{
+   printf( "%s{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+           first ? "\n" : ",\n", kind, pid, tid, name.c_str( ) );
+   first = false;
+}
+
+/**
+ * @brief writeChromeTrace function.
+ *
+ * @details prints the trace as Chrome Trace Event JSON.
+ *
+ * @param in: sink, records, count
+ *
+ * @note Each process, CPU core and device unit gets its own track, grouped
+ *       under "Processes", "CPU cores" and "Devices". A process track holds
+ *       the life of the process with its operations nested inside; an I/O
+ *       operation there spans from the request to the completion, queueing
+ *       included. A unit serves its jobs in order, so its track shows each
+ *       job from when the previous one finished, or from the request if the
+ *       unit was idle. Memory operations go on the core the process last ran
+ *       on, and on no core before its first run on a multi-core machine.
+ *       A page fault ends the memory block slice it interrupts, and the
+ *       page-in after it is shown like an I/O operation.
+ */
+void writeChromeTrace( logSink &sink, const traceRecord records[], size_t count )
+{
+   vector<chromeProcess> processes;
+   map< pair<int, int>, chromeUnit > units;
+   map< pair<int, int>, chromeUnit >::iterator found;
+   chromeUnit fresh;
+   ostringstream name;
+   set<int> cores;
+   bool first = true;
+   bool multiCore = false;
+   size_t index = 0;
+   int id = 0;
+
+   for( index = 0; index < count; index++ )
+   {
+      if( ( records[index].type == CPU_START ) && ( records[index].instance >= 0 ) )
+      {
+         multiCore = true;
+      }
+   }
+
+   printf( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" );
+   chromeName( first, "process_name", CHROME_PROCESSES, 0, "Processes" );
+   chromeName( first, "process_name", CHROME_CORES, 0, "CPU cores" );
+   chromeName( first, "process_name", CHROME_DEVICES, 0, "Devices" );
+
+   for( index = 0; index < count; index++ )
+   {
+      const traceRecord &record = records[index];
+
+      id = record.processID;
+
+      if( id >= (int) processes.size( ) )
+      {
+         processes.resize( id + 1, chromeProcess( ) );
+      }
+
+      chromeProcess &process = processes[id];
+
+      switch( record.type )
+      {
+         case PROCESS_START:
+            process.lifeStart = record.time;
+            process.core = multiCore ? -1 : 0;
+            name.str( "" );
+            name << "Process " << id;
+            chromeName( first, "thread_name", CHROME_PROCESSES, id, name.str( ) );
+            break;
+
+         case PROCESS_REMOVE:
+            name.str( "" );
+            name << "Process " << id;
+            chromeSlice( first, name.str( ), CHROME_PROCESSES, id, process.lifeStart, record.time );
+            break;
+
+         case CPU_START:
+            process.opStart = record.time;
+            process.core = multiCore ? record.instance : 0;
+            break;
+
+         case MEMORY_ALLOCATE:
+         case BLOCK_START:
+         case INPUT_START:
+         case OUTPUT_START:
+            process.opStart = record.time;
+            break;
+
+         case CPU_END:
+         case CPU_PREEMPT:
+         case MEMORY_ALLOCATED:
+         case MEMORY_FAILED:
+         case BLOCK_END:
+         case PAGE_FAULT:
+            name.str( "" );
+
+            if( ( record.type == CPU_END ) || ( record.type == CPU_PREEMPT ) )
+            {
+               name << "run";
+            }
+            else if( ( record.type == BLOCK_END ) || ( record.type == PAGE_FAULT ) )
+            {
+               name << "memory block";
+            }
+            else
+            {
+               name << "allocate memory";
+            }
+
+            chromeSlice( first, name.str( ), CHROME_PROCESSES, id, process.opStart, record.time );
+
+            if( process.core >= 0 )
+            {
+               if( cores.insert( process.core ).second )
+               {
+                  name.str( "" );
+                  name << "Core " << process.core;
+                  chromeName( first, "thread_name", CHROME_CORES, process.core, name.str( ) );
+               }
+
+               name.str( "" );
+               name << "Process " << id;
+               chromeSlice( first, name.str( ), CHROME_CORES, process.core, process.opStart, record.time );
+            }
+
+            process.opStart = record.time;
+            break;
+
+         case INPUT_END:
+         case OUTPUT_END:
+         case PAGE_LOADED:
+            name.str( "" );
+
+            if( record.type == PAGE_LOADED )
+            {
+               name << "page in";
+            }
+            else
+            {
+               if( ( record.device >= 0 ) && ( record.device < (int) sink.deviceNames.size( ) ) )
+               {
+                  name << sink.deviceNames[record.device] << " ";
+               }
+               name << ( ( record.type == INPUT_END ) ? "input" : "output" );
+            }
+            chromeSlice( first, name.str( ), CHROME_PROCESSES, id, process.opStart, record.time );
+
+            if( record.instance < 0 )
+            {
+               break;
+            }
+
+            found = units.find( make_pair( (int) record.device, record.instance ) );
+
+            if( found == units.end( ) )
+            {
+               fresh.track = units.size( );
+               fresh.lastEnd = 0;
+               found = units.insert( make_pair( make_pair( (int) record.device, record.instance ), fresh ) ).first;
+
+               name.str( "" );
+
+               if( ( record.device >= 0 ) && ( record.device < (int) sink.deviceNames.size( ) ) )
+               {
+                  if( sink.unitNames[record.device].length( ) > 0 )
+                  {
+                     name << sink.unitNames[record.device] << " " << record.instance;
+                  }
+                  else
+                  {
+                     name << sink.deviceNames[record.device];
+                  }
+               }
+               chromeName( first, "thread_name", CHROME_DEVICES, fresh.track, name.str( ) );
+            }
+
+            name.str( "" );
+            name << "Process " << id;
+            chromeSlice( first, name.str( ), CHROME_DEVICES, found->second.track,
+                         max( process.opStart, found->second.lastEnd ), record.time );
+            found->second.lastEnd = record.time;
+            break;
+      }
+   }
+
+   printf( "\n]}\n" );
+}